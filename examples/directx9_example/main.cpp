@@ -108,18 +108,24 @@ int main(int, char**)
     ZeroMemory(&msg, sizeof(msg));
     ShowWindow(hwnd, SW_SHOWDEFAULT);
     UpdateWindow(hwnd);
+    bool frame_rendered = false;
     while (msg.message != WM_QUIT)
     {
         // You can read the io.WantCaptureMouse, io.WantCaptureKeyboard flags to tell if dear imgui wants to use your inputs.
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application.
         // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application.
         // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
+        // When dear imgui has nothing to update (see io.WantNextFrame), sleep until a message arrives or the next frame is due, waking up at least once per second.
+        if (frame_rendered && !io.WantNextFrame)
+            MsgWaitForMultipleObjectsEx(0, NULL, (DWORD)((io.NextFrameTimeout < 1.0f ? io.NextFrameTimeout : 1.0f) * 1000.0f) + 1, QS_ALLINPUT, MWMO_INPUTAVAILABLE);
+        frame_rendered = false;
         if (PeekMessage(&msg, NULL, 0U, 0U, PM_REMOVE))
         {
             TranslateMessage(&msg);
             DispatchMessage(&msg);
             continue;
         }
+        frame_rendered = true;
         ImGui_ImplDX9_NewFrame();
 
         // 1. Show a simple window.
@@ -3,6 +3,7 @@
 
 // Implemented features:
 //  [X] User texture binding. Cast 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID in imgui.cpp.
+//  [X] Font atlas updates: uploads io.Fonts->TexUpdateRect every frame, for ImFontAtlasFlags_DynamicGlyphs.
 
 // **DO NOT USE THIS CODE IF YOUR CODE/ENGINE IS USING MODERN OPENGL (SHADERS, VBO, VAO, etc.)**
 // **Prefer using the code in the opengl3_example/ folder**
@@ -50,11 +51,38 @@
 // GLFW data
 static GLFWwindow*  g_Window = NULL;
 static double       g_Time = 0.0f;
-static bool         g_MouseJustPressed[3] = { false, false, false };
+static bool         g_MouseButtonEvents = false;    // Set when mouse button callbacks are received: buttons go through the input event queue instead of being polled
 static GLFWcursor*  g_MouseCursors[ImGuiMouseCursor_COUNT] = { 0 };
 
 // OpenGL data
 static GLuint       g_FontTexture = 0;
+static int          g_FontTextureWidth = 0, g_FontTextureHeight = 0;
+
+// Upload the glyphs rasterized since the last frame (ImFontAtlasFlags_DynamicGlyphs). The texture is respecified when the atlas grew.
+static void ImGui_ImplGlfwGL2_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    const ImVec4 rect = atlas->TexUpdateRect;
+    if (!g_FontTexture || rect.x >= rect.z)
+        return;
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+    if (width != g_FontTextureWidth || height != g_FontTextureHeight)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        g_FontTextureWidth = width;
+        g_FontTextureHeight = height;
+    }
+    else
+    {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)rect.x, (GLint)rect.y, (GLsizei)(rect.z - rect.x), (GLsizei)(rect.w - rect.y), GL_RGBA, GL_UNSIGNED_BYTE, pixels + ((int)rect.y * width + (int)rect.x) * 4);
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    atlas->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+}
 
 // OpenGL2 Render function.
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call this directly from your main loop)
@@ -72,6 +100,7 @@ void ImGui_ImplGlfwGL2_RenderDrawData(ImDrawData* draw_data)
     // We are using the OpenGL fixed pipeline to make the example code simpler to read!
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, vertex/texcoord/color pointers, polygon fill.
     GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    ImGui_ImplGlfwGL2_UpdateFontsTexture();
     GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
     GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
     GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box); 
@@ -152,30 +181,32 @@ static void ImGui_ImplGlfwGL2_SetClipboardText(void* user_data, const char* text
 
 void ImGui_ImplGlfw_MouseButtonCallback(GLFWwindow*, int button, int action, int /*mods*/)
 {
-    if (action == GLFW_PRESS && button >= 0 && button < 3)
-        g_MouseJustPressed[button] = true;
+    // Queued, so that presses and releases shorter than a frame are not lost
+    ImGuiIO& io = ImGui::GetIO();
+    if (button >= 0 && button < 3)
+        io.AddMouseButtonEvent(button, action == GLFW_PRESS, glfwGetTime());
+    g_MouseButtonEvents = true;
 }
 
 void ImGui_ImplGlfw_ScrollCallback(GLFWwindow*, double xoffset, double yoffset)
 {
     ImGuiIO& io = ImGui::GetIO();
-    io.MouseWheelH += (float)xoffset;
-    io.MouseWheel += (float)yoffset;
+    io.AddMouseWheelEvent((float)xoffset, (float)yoffset, glfwGetTime());
 }
 
-void ImGui_ImplGlfw_KeyCallback(GLFWwindow*, int key, int, int action, int mods)
+void ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int key, int, int action, int mods)
 {
     ImGuiIO& io = ImGui::GetIO();
-    if (action == GLFW_PRESS)
-        io.KeysDown[key] = true;
-    if (action == GLFW_RELEASE)
-        io.KeysDown[key] = false;
+    const double time = glfwGetTime();
+    if (key >= 0 && key < IM_ARRAYSIZE(io.KeysDown) && (action == GLFW_PRESS || action == GLFW_RELEASE))
+        io.AddKeyEvent(key, action == GLFW_PRESS, time);
 
     (void)mods; // Modifiers are not reliable across systems
-    io.KeyCtrl = io.KeysDown[GLFW_KEY_LEFT_CONTROL] || io.KeysDown[GLFW_KEY_RIGHT_CONTROL];
-    io.KeyShift = io.KeysDown[GLFW_KEY_LEFT_SHIFT] || io.KeysDown[GLFW_KEY_RIGHT_SHIFT];
-    io.KeyAlt = io.KeysDown[GLFW_KEY_LEFT_ALT] || io.KeysDown[GLFW_KEY_RIGHT_ALT];
-    io.KeySuper = io.KeysDown[GLFW_KEY_LEFT_SUPER] || io.KeysDown[GLFW_KEY_RIGHT_SUPER];
+    const bool ctrl = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS;
+    const bool shift = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS;
+    const bool alt = glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS;
+    const bool super = glfwGetKey(window, GLFW_KEY_LEFT_SUPER) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SUPER) == GLFW_PRESS;
+    io.AddKeyModsEvent(ctrl, shift, alt, super, time);
 }
 
 void ImGui_ImplGlfw_CharCallback(GLFWwindow*, unsigned int c)
@@ -202,6 +233,9 @@ bool ImGui_ImplGlfwGL2_CreateDeviceObjects()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    g_FontTextureWidth = width;
+    g_FontTextureHeight = height;
+    io.Fonts->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
 
     // Store our identifier
     io.Fonts->TexID = (void *)(intptr_t)g_FontTexture;
@@ -317,7 +351,7 @@ void ImGui_ImplGlfwGL2_NewFrame()
     g_Time = current_time;
 
     // Setup inputs
-    // (we already got mouse wheel, keyboard keys & characters from glfw callbacks polled in glfwPollEvents())
+    // (we already queued mouse buttons, mouse wheel, keyboard keys & characters from glfw callbacks polled in glfwPollEvents())
     if (glfwGetWindowAttrib(g_Window, GLFW_FOCUSED))
     {
         // Set OS mouse position if requested (only used when ImGuiConfigFlags_NavEnableSetMousePos is enabled by user)
@@ -337,12 +371,10 @@ void ImGui_ImplGlfwGL2_NewFrame()
         io.MousePos = ImVec2(-FLT_MAX,-FLT_MAX);
     }
 
-    for (int i = 0; i < 3; i++)
-    {
-        // If a mouse press event came, always pass it as "mouse held this frame", so we don't miss click-release events that are shorter than 1 frame.
-        io.MouseDown[i] = g_MouseJustPressed[i] || glfwGetMouseButton(g_Window, i) != 0;
-        g_MouseJustPressed[i] = false;
-    }
+    // Without the mouse button callback (see ImGui_ImplGlfw_MouseButtonCallback), poll the current state: presses and releases shorter than a frame may be lost
+    if (!g_MouseButtonEvents)
+        for (int i = 0; i < 3; i++)
+            io.MouseDown[i] = glfwGetMouseButton(g_Window, i) != 0;
 
     // Update OS/hardware mouse cursor if imgui isn't drawing a software cursor
     if ((io.ConfigFlags & ImGuiConfigFlags_NoSetMouseCursor) == 0 && glfwGetInputMode(g_Window, GLFW_CURSOR) != GLFW_CURSOR_DISABLED)
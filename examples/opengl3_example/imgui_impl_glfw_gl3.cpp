@@ -4,6 +4,7 @@
 
 // Implemented features:
 //  [X] User texture binding. Cast 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID in imgui.cpp.
+//  [X] Font atlas updates: uploads io.Fonts->TexUpdateRect every frame, for ImFontAtlasFlags_DynamicGlyphs.
 //  [X] Gamepad navigation mapping. Enable with 'io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad'.
 
 // You can copy and use unmodified imgui_impl_* files in your project. See main.cpp for an example of using this.
@@ -13,6 +14,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2018-03-22: OpenGL: Upload the font texture with ImFontAtlas::GetTexDataRowsAsRGBA32(), without keeping a RGBA32 copy of the atlas in memory.
+//  2018-03-21: OpenGL: Added a signed distance field path to the fragment shader, used for the font texture with ImFontAtlasFlags_SDF.
 //  2018-03-20: Misc: Setup io.BackendFlags ImGuiBackendFlags_HasMouseCursors and ImGuiBackendFlags_HasSetMousePos flags + honor ImGuiConfigFlags_NoSetMouseCursor flag.
 //  2018-03-06: OpenGL: Added const char* glsl_version parameter to ImGui_ImplGlfwGL3_Init() so user can override the GLSL version e.g. "#version 150".
 //  2018-02-23: OpenGL: Create the VAO in the render function so the setup can more easily be used with multiple shared GL context.
@@ -53,17 +56,50 @@
 // GLFW data
 static GLFWwindow*  g_Window = NULL;
 static double       g_Time = 0.0f;
-static bool         g_MouseJustPressed[3] = { false, false, false };
+static bool         g_MouseButtonEvents = false;    // Set when mouse button callbacks are received: buttons go through the input event queue instead of being polled
 static GLFWcursor*  g_MouseCursors[ImGuiMouseCursor_COUNT] = { 0 };
 
 // OpenGL3 data
 static char         g_GlslVersion[32] = "#version 150";
 static GLuint       g_FontTexture = 0;
+static int          g_FontTextureWidth = 0, g_FontTextureHeight = 0;
 static int          g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
-static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
+static int          g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0, g_AttribLocationTexSDF = 0;
 static int          g_AttribLocationPosition = 0, g_AttribLocationUV = 0, g_AttribLocationColor = 0;
 static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
 
+// Upload rows of the font texture, expanded to RGBA32 by ImFontAtlas::GetTexDataRowsAsRGBA32(). The texture needs to be bound.
+static void ImGui_ImplGlfwGL3_UploadFontsTextureRows(const unsigned char* pixels, int y, int rows_count, void*)
+{
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y, g_FontTextureWidth, rows_count, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
+
+// Upload the glyphs rasterized since the last frame (ImFontAtlasFlags_DynamicGlyphs). The texture is respecified when the atlas grew.
+static void ImGui_ImplGlfwGL3_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    const ImVec4 rect = atlas->TexUpdateRect;
+    if (!g_FontTexture || rect.x >= rect.z)
+        return;
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    if (width != g_FontTextureWidth || height != g_FontTextureHeight)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        g_FontTextureWidth = width;
+        g_FontTextureHeight = height;
+        atlas->GetTexDataRowsAsRGBA32(ImGui_ImplGlfwGL3_UploadFontsTextureRows, NULL);
+    }
+    else
+    {
+        atlas->GetTexDataRowsAsRGBA32(ImGui_ImplGlfwGL3_UploadFontsTextureRows, NULL, (int)rect.y, (int)rect.w);
+    }
+    atlas->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
 // OpenGL3 Render function.
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call this directly from your main loop)
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly, in order to be able to run within any OpenGL engine that doesn't do so. 
@@ -82,6 +118,7 @@ void ImGui_ImplGlfwGL3_RenderDrawData(ImDrawData* draw_data)
     glActiveTexture(GL_TEXTURE0);
     GLint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, &last_program);
     GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    ImGui_ImplGlfwGL3_UpdateFontsTexture();
     GLint last_sampler; glGetIntegerv(GL_SAMPLER_BINDING, &last_sampler);
     GLint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
     GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
@@ -120,6 +157,8 @@ void ImGui_ImplGlfwGL3_RenderDrawData(ImDrawData* draw_data)
     };
     glUseProgram(g_ShaderHandle);
     glUniform1i(g_AttribLocationTex, 0);
+    glUniform1i(g_AttribLocationTexSDF, 0);
+    const bool font_tex_sdf = (io.Fonts->Flags & ImFontAtlasFlags_SDF) != 0;
     glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
     glBindSampler(0, 0); // Rely on combined texture/sampler state.
 
@@ -132,8 +171,10 @@ void ImGui_ImplGlfwGL3_RenderDrawData(ImDrawData* draw_data)
     glEnableVertexAttribArray(g_AttribLocationPosition);
     glEnableVertexAttribArray(g_AttribLocationUV);
     glEnableVertexAttribArray(g_AttribLocationColor);
-    glVertexAttribPointer(g_AttribLocationPosition, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
-    glVertexAttribPointer(g_AttribLocationUV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
+    const GLenum pos_type = (draw_data->VtxFormat == ImDrawVertFormat_CompactUVHalfPos) ? GL_HALF_FLOAT : GL_FLOAT;   // See IMGUI_USE_COMPACT_DRAWVERT in imconfig.h
+    const GLenum uv_type = (draw_data->VtxFormat == ImDrawVertFormat_Default) ? GL_FLOAT : GL_UNSIGNED_SHORT;
+    glVertexAttribPointer(g_AttribLocationPosition, 2, pos_type, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
+    glVertexAttribPointer(g_AttribLocationUV, 2, uv_type, uv_type == GL_FLOAT ? GL_FALSE : GL_TRUE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
     glVertexAttribPointer(g_AttribLocationColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
 
     // Draw
@@ -158,6 +199,8 @@ void ImGui_ImplGlfwGL3_RenderDrawData(ImDrawData* draw_data)
             else
             {
                 glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
+                if (font_tex_sdf)
+                    glUniform1i(g_AttribLocationTexSDF, pcmd->TextureId == io.Fonts->TexID);
                 glScissor((int)pcmd->ClipRect.x, (int)(fb_height - pcmd->ClipRect.w), (int)(pcmd->ClipRect.z - pcmd->ClipRect.x), (int)(pcmd->ClipRect.w - pcmd->ClipRect.y));
                 glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, idx_buffer_offset);
             }
@@ -197,30 +240,32 @@ static void ImGui_ImplGlfwGL3_SetClipboardText(void* user_data, const char* text
 
 void ImGui_ImplGlfw_MouseButtonCallback(GLFWwindow*, int button, int action, int /*mods*/)
 {
-    if (action == GLFW_PRESS && button >= 0 && button < 3)
-        g_MouseJustPressed[button] = true;
+    // Queued, so that presses and releases shorter than a frame are not lost
+    ImGuiIO& io = ImGui::GetIO();
+    if (button >= 0 && button < 3)
+        io.AddMouseButtonEvent(button, action == GLFW_PRESS, glfwGetTime());
+    g_MouseButtonEvents = true;
 }
 
 void ImGui_ImplGlfw_ScrollCallback(GLFWwindow*, double xoffset, double yoffset)
 {
     ImGuiIO& io = ImGui::GetIO();
-    io.MouseWheelH += (float)xoffset;
-    io.MouseWheel += (float)yoffset;
+    io.AddMouseWheelEvent((float)xoffset, (float)yoffset, glfwGetTime());
 }
 
-void ImGui_ImplGlfw_KeyCallback(GLFWwindow*, int key, int, int action, int mods)
+void ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int key, int, int action, int mods)
 {
     ImGuiIO& io = ImGui::GetIO();
-    if (action == GLFW_PRESS)
-        io.KeysDown[key] = true;
-    if (action == GLFW_RELEASE)
-        io.KeysDown[key] = false;
+    const double time = glfwGetTime();
+    if (key >= 0 && key < IM_ARRAYSIZE(io.KeysDown) && (action == GLFW_PRESS || action == GLFW_RELEASE))
+        io.AddKeyEvent(key, action == GLFW_PRESS, time);
 
     (void)mods; // Modifiers are not reliable across systems
-    io.KeyCtrl = io.KeysDown[GLFW_KEY_LEFT_CONTROL] || io.KeysDown[GLFW_KEY_RIGHT_CONTROL];
-    io.KeyShift = io.KeysDown[GLFW_KEY_LEFT_SHIFT] || io.KeysDown[GLFW_KEY_RIGHT_SHIFT];
-    io.KeyAlt = io.KeysDown[GLFW_KEY_LEFT_ALT] || io.KeysDown[GLFW_KEY_RIGHT_ALT];
-    io.KeySuper = io.KeysDown[GLFW_KEY_LEFT_SUPER] || io.KeysDown[GLFW_KEY_RIGHT_SUPER];
+    const bool ctrl = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS;
+    const bool shift = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS;
+    const bool alt = glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS;
+    const bool super = glfwGetKey(window, GLFW_KEY_LEFT_SUPER) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SUPER) == GLFW_PRESS;
+    io.AddKeyModsEvent(ctrl, shift, alt, super, time);
 }
 
 void ImGui_ImplGlfw_CharCallback(GLFWwindow*, unsigned int c)
@@ -236,7 +281,7 @@ bool ImGui_ImplGlfwGL3_CreateFontsTexture()
     ImGuiIO& io = ImGui::GetIO();
     unsigned char* pixels;
     int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bits (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+    io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);   // Upload as RGBA 32-bits (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider uploading the Alpha8 data instead to save on GPU memory.
 
     // Upload texture to graphics system
     GLint last_texture;
@@ -246,7 +291,11 @@ bool ImGui_ImplGlfwGL3_CreateFontsTexture()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    g_FontTextureWidth = width;
+    g_FontTextureHeight = height;
+    io.Fonts->GetTexDataRowsAsRGBA32(ImGui_ImplGlfwGL3_UploadFontsTextureRows, NULL);    // Expanded a band of rows at a time, no RGBA32 copy of the atlas is kept in memory
+    io.Fonts->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
 
     // Store our identifier
     io.Fonts->TexID = (void *)(intptr_t)g_FontTexture;
@@ -281,12 +330,20 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
 
     const GLchar* fragment_shader =
         "uniform sampler2D Texture;\n"
+        "uniform bool TextureIsSDF;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "	Out_Color = Frag_Color * texture( Texture, Frag_UV.st);\n"
+        "	vec4 tex = texture( Texture, Frag_UV.st);\n"
+        "	if (TextureIsSDF)\n"
+        "	{\n"
+        "		// Signed distance field (ImFontAtlasFlags_SDF): 0.5 on the outlines, antialiased over one screen pixel at any scale\n"
+        "		float width = max(fwidth(tex.a), 1.0 / 256.0);\n"
+        "		tex.a = clamp((tex.a - 0.5) / width + 0.5, 0.0, 1.0);\n"
+        "	}\n"
+        "	Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* vertex_shader_with_version[2] = { g_GlslVersion, vertex_shader };
@@ -305,6 +362,7 @@ bool ImGui_ImplGlfwGL3_CreateDeviceObjects()
 
     g_AttribLocationTex = glGetUniformLocation(g_ShaderHandle, "Texture");
     g_AttribLocationProjMtx = glGetUniformLocation(g_ShaderHandle, "ProjMtx");
+    g_AttribLocationTexSDF = glGetUniformLocation(g_ShaderHandle, "TextureIsSDF");
     g_AttribLocationPosition = glGetAttribLocation(g_ShaderHandle, "Position");
     g_AttribLocationUV = glGetAttribLocation(g_ShaderHandle, "UV");
     g_AttribLocationColor = glGetAttribLocation(g_ShaderHandle, "Color");
@@ -449,7 +507,7 @@ void ImGui_ImplGlfwGL3_NewFrame()
     g_Time = current_time;
 
     // Setup inputs
-    // (we already got mouse wheel, keyboard keys & characters from glfw callbacks polled in glfwPollEvents())
+    // (we already queued mouse buttons, mouse wheel, keyboard keys & characters from glfw callbacks polled in glfwPollEvents())
     if (glfwGetWindowAttrib(g_Window, GLFW_FOCUSED))
     {
         // Set OS mouse position if requested (only used when ImGuiConfigFlags_NavEnableSetMousePos is enabled by user)
@@ -469,12 +527,10 @@ void ImGui_ImplGlfwGL3_NewFrame()
         io.MousePos = ImVec2(-FLT_MAX,-FLT_MAX);
     }
 
-    for (int i = 0; i < 3; i++)
-    {
-        // If a mouse press event came, always pass it as "mouse held this frame", so we don't miss click-release events that are shorter than 1 frame.
-        io.MouseDown[i] = g_MouseJustPressed[i] || glfwGetMouseButton(g_Window, i) != 0;
-        g_MouseJustPressed[i] = false;
-    }
+    // Without the mouse button callback (see ImGui_ImplGlfw_MouseButtonCallback), poll the current state: presses and releases shorter than a frame may be lost
+    if (!g_MouseButtonEvents)
+        for (int i = 0; i < 3; i++)
+            io.MouseDown[i] = glfwGetMouseButton(g_Window, i) != 0;
 
     // Update OS/hardware mouse cursor if imgui isn't drawing a software cursor
     if ((io.ConfigFlags & ImGuiConfigFlags_NoSetMouseCursor) == 0 && glfwGetInputMode(g_Window, GLFW_CURSOR) != GLFW_CURSOR_DISABLED)
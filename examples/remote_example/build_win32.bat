@@ -0,0 +1,3 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+mkdir Debug
+cl /nologo /Zi /MD /EHsc /I ..\.. *.cpp ..\..\*.cpp ..\..\misc\remote\imgui_remote.cpp ..\..\misc\softraster\imgui_soft_raster.cpp /FeDebug/remote_example.exe /FoDebug/ /link ws2_32.lib
@@ -0,0 +1,212 @@
+// ImGui - remote example application
+// The application thread runs ImGui and streams its draw data over a loopback TCP socket with ImGuiDrawDataEncoder.
+// The viewer thread decodes it with ImGuiDrawDataDecoder and renders it with the software rasterizer, then writes the last frame to remote_example.tga.
+// Prints the bandwidth used compared to sending the full draw data every frame.
+// Usage: remote_example [frames_count]
+
+#include "imgui.h"
+#include "../../misc/remote/imgui_remote.h"
+#include "../../misc/softraster/imgui_soft_raster.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <thread>
+
+#ifdef _WIN32
+#include <winsock2.h>
+typedef SOCKET socket_t;
+typedef int socklen_t;
+#define close_socket closesocket
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+typedef int socket_t;
+#define INVALID_SOCKET -1
+#define close_socket close
+#endif
+
+static const int DisplayWidth = 1280, DisplayHeight = 720;
+
+static bool SendAll(socket_t s, const unsigned char* data, int size)
+{
+    while (size > 0)
+    {
+        int sent = (int)send(s, (const char*)data, size, 0);
+        if (sent <= 0)
+            return false;
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// Viewer
+//-----------------------------------------------------------------------------
+
+struct ViewerTextures
+{
+    ImGuiDrawDataDecoder*   Decoder;
+    ImGuiSoftTexture        SoftTextures[8];
+};
+
+static ImTextureID RemapTextureId(ImU64 sender_tex_id, void* user_data)
+{
+    ViewerTextures* vt = (ViewerTextures*)user_data;
+    for (int n = 0; n < vt->Decoder->Textures.Size && n < IM_ARRAYSIZE(vt->SoftTextures); n++)
+        if (vt->Decoder->Textures[n].SenderTexId == sender_tex_id)
+            return &vt->SoftTextures[n];
+    return NULL;
+}
+
+static void ViewerThread(unsigned short port)
+{
+    socket_t s = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(s, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        fprintf(stderr, "viewer: connect() failed\n");
+        return;
+    }
+
+    ImGuiDrawDataDecoder decoder;
+    ViewerTextures vt;
+    vt.Decoder = &decoder;
+    decoder.RemapTextureIdFn = RemapTextureId;
+    decoder.RemapTextureIdUserData = &vt;
+    ImGuiSoftRenderer renderer;
+    renderer.SetSize(DisplayWidth, DisplayHeight);
+    renderer.Clear(IM_COL32(45, 55, 60, 255));
+
+    ImVector<unsigned char> buf;
+    int buf_used = 0;
+    for (;;)
+    {
+        // Receive, then decode all complete messages
+        if (buf.Size - buf_used < 64 * 1024)
+            buf.resize(buf_used + 64 * 1024);
+        int received = (int)recv(s, (char*)buf.Data + buf_used, buf.Size - buf_used, 0);
+        if (received <= 0)
+            break;
+        buf_used += received;
+        int consumed = 0;
+        for (;;)
+        {
+            const int msg_size = ImGuiDrawDataDecoder::GetMessageSize(buf.Data + consumed, buf_used - consumed);
+            if (msg_size == 0 || msg_size > buf_used - consumed)
+                break;
+            const int msg_type = decoder.DecodeMessage(buf.Data + consumed, msg_size);
+            if (msg_type == ImGuiRemoteMsg_Texture)
+            {
+                // Pixels of the decoder textures stay valid until the texture is received again
+                for (int n = 0; n < decoder.Textures.Size && n < IM_ARRAYSIZE(vt.SoftTextures); n++)
+                {
+                    vt.SoftTextures[n].Pixels = decoder.Textures[n].Pixels.Data;
+                    vt.SoftTextures[n].Width = decoder.Textures[n].Width;
+                    vt.SoftTextures[n].Height = decoder.Textures[n].Height;
+                    vt.SoftTextures[n].BytesPerPixel = decoder.Textures[n].BytesPerPixel;
+                }
+            }
+            else if (msg_type == ImGuiRemoteMsg_Frame)
+            {
+                renderer.RenderDrawDataDamage(&decoder.DrawData, IM_COL32(45, 55, 60, 255));
+            }
+            else
+            {
+                fprintf(stderr, "viewer: corrupted message\n");
+            }
+            consumed += msg_size;
+        }
+        memmove(buf.Data, buf.Data + consumed, (size_t)(buf_used - consumed));
+        buf_used -= consumed;
+    }
+    close_socket(s);
+    printf("viewer: %d frames received, writing remote_example.tga\n", decoder.FrameCount);
+    renderer.SaveTGA("remote_example.tga");
+}
+
+//-----------------------------------------------------------------------------
+// Application
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    const int frames_count = (argc > 1) ? atoi(argv[1]) : 300;
+
+#ifdef _WIN32
+    WSADATA wsa_data;
+    WSAStartup(MAKEWORD(2, 2), &wsa_data);
+#endif
+
+    // Listen on an ephemeral loopback port
+    socket_t listen_socket = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (bind(listen_socket, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_socket, 1) != 0 || getsockname(listen_socket, (sockaddr*)&addr, &addr_len) != 0)
+    {
+        fprintf(stderr, "Failed to listen on loopback\n");
+        return 1;
+    }
+    std::thread viewer(ViewerThread, ntohs(addr.sin_port));
+    socket_t s = accept(listen_socket, NULL, NULL);
+    close_socket(listen_socket);
+    if (s == INVALID_SOCKET)
+        return 1;
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float)DisplayWidth, (float)DisplayHeight);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.OptDamageRects = true;   // Sent along with the frames, so the viewer only redraws what changed
+
+    // Send the font atlas once
+    ImGuiDrawDataEncoder encoder;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsAlpha8(&tex_pixels, &tex_w, &tex_h);
+    io.Fonts->TexID = (ImTextureID)1;
+    encoder.EncodeTexture(io.Fonts->TexID, tex_pixels, tex_w, tex_h, 1);
+    SendAll(s, encoder.Buffer.Data, encoder.Buffer.Size);
+
+    double raw_bytes = 0.0, sent_bytes = 0.0;
+    for (int n = 0; n < frames_count; n++)
+    {
+        // Simulate a user moving the mouse around and clicking from time to time
+        io.MousePos = ImVec2(400.0f + 300.0f * sinf(n * 0.02f), 300.0f + 200.0f * cosf(n * 0.013f));
+        io.MouseDown[0] = (n % 90) < 2;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(20, 20), ImGuiCond_FirstUseEver);
+        ImGui::ShowDemoWindow();
+        ImGui::SetNextWindowPos(ImVec2(700, 20), ImGuiCond_FirstUseEver);
+        ImGui::ShowMetricsWindow();
+        ImGui::Render();
+
+        ImDrawData* draw_data = ImGui::GetDrawData();
+        for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+        {
+            const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+            raw_bytes += draw_list->VtxBuffer.Size * sizeof(ImDrawVert) + draw_list->IdxBuffer.Size * sizeof(ImDrawIdx) + draw_list->CmdBuffer.Size * sizeof(ImDrawCmd);
+        }
+        encoder.EncodeFrame(draw_data);
+        sent_bytes += encoder.Buffer.Size;
+        if (!SendAll(s, encoder.Buffer.Data, encoder.Buffer.Size))
+            break;
+    }
+    close_socket(s);
+    viewer.join();
+
+    printf("%d frames: full draw data %.1f KB/frame, sent %.1f KB/frame (%.1f%%)\n", frames_count, raw_bytes / frames_count / 1024.0, sent_bytes / frames_count / 1024.0, raw_bytes > 0.0 ? sent_bytes * 100.0 / raw_bytes : 0.0);
+    ImGui::DestroyContext();
+#ifdef _WIN32
+    WSACleanup();
+#endif
+    return 0;
+}
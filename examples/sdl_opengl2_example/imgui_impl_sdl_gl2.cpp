@@ -3,6 +3,7 @@
 
 // Implemented features:
 //  [X] User texture binding. Cast 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID in imgui.cpp.
+//  [X] Font atlas updates: uploads io.Fonts->TexUpdateRect every frame, for ImFontAtlasFlags_DynamicGlyphs.
 // Missing features:
 //  [ ] SDL2 handling of IME under Windows appears to be broken and it explicitly disable the regular Windows IME. You can restore Windows IME by compiling SDL with SDL_DISABLE_WINDOWS_IME.
 
@@ -45,10 +46,36 @@
 
 // Data
 static Uint64       g_Time = 0;
-static bool         g_MousePressed[3] = { false, false, false };
 static GLuint       g_FontTexture = 0;
+static int          g_FontTextureWidth = 0, g_FontTextureHeight = 0;
 static SDL_Cursor*  g_MouseCursors[ImGuiMouseCursor_COUNT] = { 0 };
 
+// Upload the glyphs rasterized since the last frame (ImFontAtlasFlags_DynamicGlyphs). The texture is respecified when the atlas grew.
+static void ImGui_ImplSdlGL2_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    const ImVec4 rect = atlas->TexUpdateRect;
+    if (!g_FontTexture || rect.x >= rect.z)
+        return;
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+    if (width != g_FontTextureWidth || height != g_FontTextureHeight)
+    {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+        g_FontTextureWidth = width;
+        g_FontTextureHeight = height;
+    }
+    else
+    {
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)rect.x, (GLint)rect.y, (GLsizei)(rect.z - rect.x), (GLsizei)(rect.w - rect.y), GL_ALPHA, GL_UNSIGNED_BYTE, pixels + ((int)rect.y * width + (int)rect.x));
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    atlas->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+}
+
 // OpenGL2 Render function.
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call this directly from your main loop)
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly, in order to be able to run within any OpenGL engine that doesn't do so. 
@@ -65,6 +92,7 @@ void ImGui_ImplSdlGL2_RenderDrawData(ImDrawData* draw_data)
     // We are using the OpenGL fixed pipeline to make the example code simpler to read!
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, vertex/texcoord/color pointers, polygon fill.
     GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    ImGui_ImplSdlGL2_UpdateFontsTexture();
     GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
     GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
     GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box); 
@@ -154,17 +182,18 @@ bool ImGui_ImplSdlGL2_ProcessEvent(SDL_Event* event)
     {
     case SDL_MOUSEWHEEL:
         {
-            if (event->wheel.x > 0) io.MouseWheelH += 1;
-            if (event->wheel.x < 0) io.MouseWheelH -= 1;
-            if (event->wheel.y > 0) io.MouseWheel += 1;
-            if (event->wheel.y < 0) io.MouseWheel -= 1;
+            float wheel_x = (event->wheel.x > 0) ? 1.0f : (event->wheel.x < 0) ? -1.0f : 0.0f;
+            float wheel_y = (event->wheel.y > 0) ? 1.0f : (event->wheel.y < 0) ? -1.0f : 0.0f;
+            io.AddMouseWheelEvent(wheel_x, wheel_y, event->wheel.timestamp / 1000.0);
             return true;
         }
     case SDL_MOUSEBUTTONDOWN:
+    case SDL_MOUSEBUTTONUP:
         {
-            if (event->button.button == SDL_BUTTON_LEFT) g_MousePressed[0] = true;
-            if (event->button.button == SDL_BUTTON_RIGHT) g_MousePressed[1] = true;
-            if (event->button.button == SDL_BUTTON_MIDDLE) g_MousePressed[2] = true;
+            // Queued, so that presses and releases shorter than a frame are not lost
+            int button = (event->button.button == SDL_BUTTON_LEFT) ? 0 : (event->button.button == SDL_BUTTON_RIGHT) ? 1 : (event->button.button == SDL_BUTTON_MIDDLE) ? 2 : -1;
+            if (button != -1)
+                io.AddMouseButtonEvent(button, event->type == SDL_MOUSEBUTTONDOWN, event->button.timestamp / 1000.0);
             return true;
         }
     case SDL_TEXTINPUT:
@@ -177,11 +206,9 @@ bool ImGui_ImplSdlGL2_ProcessEvent(SDL_Event* event)
         {
             int key = event->key.keysym.scancode;
             IM_ASSERT(key >= 0 && key < IM_ARRAYSIZE(io.KeysDown));
-            io.KeysDown[key] = (event->type == SDL_KEYDOWN);
-            io.KeyShift = ((SDL_GetModState() & KMOD_SHIFT) != 0);
-            io.KeyCtrl = ((SDL_GetModState() & KMOD_CTRL) != 0);
-            io.KeyAlt = ((SDL_GetModState() & KMOD_ALT) != 0);
-            io.KeySuper = ((SDL_GetModState() & KMOD_GUI) != 0);
+            SDL_Keymod mods = SDL_GetModState();
+            io.AddKeyEvent(key, event->type == SDL_KEYDOWN, event->key.timestamp / 1000.0);
+            io.AddKeyModsEvent((mods & KMOD_CTRL) != 0, (mods & KMOD_SHIFT) != 0, (mods & KMOD_ALT) != 0, (mods & KMOD_GUI) != 0, event->key.timestamp / 1000.0);
             return true;
         }
     }
@@ -205,6 +232,9 @@ bool ImGui_ImplSdlGL2_CreateDeviceObjects()
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
     glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, width, height, 0, GL_ALPHA, GL_UNSIGNED_BYTE, pixels);
+    g_FontTextureWidth = width;
+    g_FontTextureHeight = height;
+    io.Fonts->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
 
     // Store our identifier
     io.Fonts->TexID = (void *)(intptr_t)g_FontTexture;
@@ -310,22 +340,16 @@ void ImGui_ImplSdlGL2_NewFrame(SDL_Window *window)
     io.DeltaTime = g_Time > 0 ? (float)((double)(current_time - g_Time) / frequency) : (float)(1.0f / 60.0f);
     g_Time = current_time;
 
-    // Setup mouse inputs (we already got mouse wheel, keyboard keys & characters from our event handler)
+    // Setup mouse inputs (we already queued mouse buttons, mouse wheel, keyboard keys & characters from our event handler)
     int mx, my;
     Uint32 mouse_buttons = SDL_GetMouseState(&mx, &my);
     io.MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
-    io.MouseDown[0] = g_MousePressed[0] || (mouse_buttons & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0;  // If a mouse press event came, always pass it as "mouse held this frame", so we don't miss click-release events that are shorter than 1 frame.
-    io.MouseDown[1] = g_MousePressed[1] || (mouse_buttons & SDL_BUTTON(SDL_BUTTON_RIGHT)) != 0;
-    io.MouseDown[2] = g_MousePressed[2] || (mouse_buttons & SDL_BUTTON(SDL_BUTTON_MIDDLE)) != 0;
-    g_MousePressed[0] = g_MousePressed[1] = g_MousePressed[2] = false;
 
     // We need to use SDL_CaptureMouse() to easily retrieve mouse coordinates outside of the client area. This is only supported from SDL 2.0.4 (released Jan 2016)
 #if (SDL_MAJOR_VERSION >= 2) && (SDL_MINOR_VERSION >= 0) && (SDL_PATCHLEVEL >= 4)   
     if ((SDL_GetWindowFlags(window) & (SDL_WINDOW_MOUSE_FOCUS | SDL_WINDOW_MOUSE_CAPTURE)) != 0)
         io.MousePos = ImVec2((float)mx, (float)my);
-    bool any_mouse_button_down = false;
-    for (int n = 0; n < IM_ARRAYSIZE(io.MouseDown); n++)
-        any_mouse_button_down |= io.MouseDown[n];
+    bool any_mouse_button_down = (mouse_buttons & (SDL_BUTTON_LMASK | SDL_BUTTON_MMASK | SDL_BUTTON_RMASK)) != 0;
     if (any_mouse_button_down && (SDL_GetWindowFlags(window) & SDL_WINDOW_MOUSE_CAPTURE) == 0)
         SDL_CaptureMouse(SDL_TRUE);
     if (!any_mouse_button_down && (SDL_GetWindowFlags(window) & SDL_WINDOW_MOUSE_CAPTURE) != 0)
@@ -333,6 +357,7 @@ void ImGui_ImplSdlGL2_NewFrame(SDL_Window *window)
 #else
     if ((SDL_GetWindowFlags(window) & SDL_WINDOW_INPUT_FOCUS) != 0)
         io.MousePos = ImVec2((float)mx, (float)my);
+    (void)mouse_buttons;
 #endif
 
     // Update OS/hardware mouse cursor if imgui isn't drawing a software cursor
@@ -70,9 +70,12 @@ int main(int, char**)
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application.
         // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application.
         // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
+        // When dear imgui has nothing to update (see io.WantNextFrame), sleep until an event arrives or the next frame is due, waking up at least once per second.
         SDL_Event event;
-        while (SDL_PollEvent(&event))
+        bool wait_event = !io.WantNextFrame;
+        while (wait_event ? SDL_WaitEventTimeout(&event, (int)((io.NextFrameTimeout < 1.0f ? io.NextFrameTimeout : 1.0f) * 1000.0f) + 1) : SDL_PollEvent(&event))
         {
+            wait_event = false;
             ImGui_ImplSdlGL2_ProcessEvent(&event);
             if (event.type == SDL_QUIT)
                 done = true;
@@ -42,7 +42,7 @@
 // GLFW data
 static GLFWwindow*  g_Window = NULL;
 static double       g_Time = 0.0f;
-static bool         g_MouseJustPressed[3] = { false, false, false };
+static bool         g_MouseButtonEvents = false;    // Set when mouse button callbacks are received: buttons go through the input event queue instead of being polled
 static GLFWcursor*  g_MouseCursors[ImGuiMouseCursor_COUNT] = { 0 };
 
 // Vulkan data
@@ -346,30 +346,32 @@ static void ImGui_ImplGlfwVulkan_SetClipboardText(void* user_data, const char* t
 
 void ImGui_ImplGlfw_MouseButtonCallback(GLFWwindow*, int button, int action, int /*mods*/)
 {
-    if (action == GLFW_PRESS && button >= 0 && button < 3)
-        g_MouseJustPressed[button] = true;
+    // Queued, so that presses and releases shorter than a frame are not lost
+    ImGuiIO& io = ImGui::GetIO();
+    if (button >= 0 && button < 3)
+        io.AddMouseButtonEvent(button, action == GLFW_PRESS, glfwGetTime());
+    g_MouseButtonEvents = true;
 }
 
 void ImGui_ImplGlfw_ScrollCallback(GLFWwindow*, double xoffset, double yoffset)
 {
     ImGuiIO& io = ImGui::GetIO();
-    io.MouseWheelH += (float)xoffset;
-    io.MouseWheel += (float)yoffset;
+    io.AddMouseWheelEvent((float)xoffset, (float)yoffset, glfwGetTime());
 }
 
-void ImGui_ImplGlfw_KeyCallback(GLFWwindow*, int key, int, int action, int mods)
+void ImGui_ImplGlfw_KeyCallback(GLFWwindow* window, int key, int, int action, int mods)
 {
     ImGuiIO& io = ImGui::GetIO();
-    if (action == GLFW_PRESS)
-        io.KeysDown[key] = true;
-    if (action == GLFW_RELEASE)
-        io.KeysDown[key] = false;
+    const double time = glfwGetTime();
+    if (key >= 0 && key < IM_ARRAYSIZE(io.KeysDown) && (action == GLFW_PRESS || action == GLFW_RELEASE))
+        io.AddKeyEvent(key, action == GLFW_PRESS, time);
 
     (void)mods; // Modifiers are not reliable across systems
-    io.KeyCtrl = io.KeysDown[GLFW_KEY_LEFT_CONTROL] || io.KeysDown[GLFW_KEY_RIGHT_CONTROL];
-    io.KeyShift = io.KeysDown[GLFW_KEY_LEFT_SHIFT] || io.KeysDown[GLFW_KEY_RIGHT_SHIFT];
-    io.KeyAlt = io.KeysDown[GLFW_KEY_LEFT_ALT] || io.KeysDown[GLFW_KEY_RIGHT_ALT];
-    io.KeySuper = io.KeysDown[GLFW_KEY_LEFT_SUPER] || io.KeysDown[GLFW_KEY_RIGHT_SUPER];
+    const bool ctrl = glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS;
+    const bool shift = glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS;
+    const bool alt = glfwGetKey(window, GLFW_KEY_LEFT_ALT) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_ALT) == GLFW_PRESS;
+    const bool super = glfwGetKey(window, GLFW_KEY_LEFT_SUPER) == GLFW_PRESS || glfwGetKey(window, GLFW_KEY_RIGHT_SUPER) == GLFW_PRESS;
+    io.AddKeyModsEvent(ctrl, shift, alt, super, time);
 }
 
 void ImGui_ImplGlfw_CharCallback(GLFWwindow*, unsigned int c)
@@ -851,7 +853,7 @@ void ImGui_ImplGlfwVulkan_NewFrame()
     g_Time = current_time;
 
     // Setup inputs
-    // (we already got mouse wheel, keyboard keys & characters from glfw callbacks polled in glfwPollEvents())
+    // (we already queued mouse buttons, mouse wheel, keyboard keys & characters from glfw callbacks polled in glfwPollEvents())
     if (glfwGetWindowAttrib(g_Window, GLFW_FOCUSED))
     {
         double mouse_x, mouse_y;
@@ -863,11 +865,10 @@ void ImGui_ImplGlfwVulkan_NewFrame()
         io.MousePos = ImVec2(-FLT_MAX,-FLT_MAX);
     }
 
-    for (int i = 0; i < 3; i++)
-    {
-        io.MouseDown[i] = g_MouseJustPressed[i] || glfwGetMouseButton(g_Window, i) != 0;    // If a mouse press event came, always pass it as "mouse held this frame", so we don't miss click-release events that are shorter than 1 frame.
-        g_MouseJustPressed[i] = false;
-    }
+    // Without the mouse button callback (see ImGui_ImplGlfw_MouseButtonCallback), poll the current state: presses and releases shorter than a frame may be lost
+    if (!g_MouseButtonEvents)
+        for (int i = 0; i < 3; i++)
+            io.MouseDown[i] = glfwGetMouseButton(g_Window, i) != 0;
 
     // Update OS/hardware mouse cursor if imgui isn't drawing a software cursor
     if ((io.ConfigFlags & ImGuiConfigFlags_NoSetMouseCursor) == 0)
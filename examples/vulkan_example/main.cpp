@@ -698,7 +698,11 @@ int main(int, char**)
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application.
         // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application.
         // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
-        glfwPollEvents();
+        // When dear imgui has nothing to update (see io.WantNextFrame), sleep until an event arrives or the next frame is due, waking up at least once per second.
+        if (io.WantNextFrame)
+            glfwPollEvents();
+        else
+            glfwWaitEventsTimeout(io.NextFrameTimeout < 1.0f ? io.NextFrameTimeout : 1.0f);
 
         if (g_ResizeWanted)
             resize_vulkan(g_ResizeWidth, g_ResizeHeight);
@@ -29,6 +29,14 @@
 //---- It is very strongly recommended to NOT disable the demo windows during development. Please read the comments in imgui_demo.cpp.
 //#define IMGUI_DISABLE_DEMO_WINDOWS
 
+//---- Don't implement the CPU profiler (io.OptProfiler has no effect, and no timer function is used)
+//#define IMGUI_DISABLE_PROFILER
+
+//---- Store the current context pointer and the other per-thread state (memory stats, decompression buffers) in thread local storage, so N threads can each run their own context concurrently.
+// Each thread calls ImGui::SetCurrentContext() with its own context. Contexts may share a font atlas created with CreateContext(shared_font_atlas), as long as it is built before the threads start.
+// Requires C++11 thread_local. Not compatible with exporting the ImGui symbols from a DLL (IMGUI_API __declspec(dllexport)).
+//#define IMGUI_USE_THREAD_LOCAL_CONTEXT
+
 //---- Don't implement ImFormatString(), ImFormatStringV() so you can reimplement them yourself.
 //#define IMGUI_DISABLE_FORMAT_STRING_FUNCTIONS
 
@@ -38,6 +46,9 @@
 //---- Pack colors to BGRA8 instead of RGBA8 (if you needed to convert from one to another anyway)
 //#define IMGUI_USE_BGRA_PACKED_COLOR
 
+//---- Don't use SSE2 intrinsics, even when the compiler targets them (used to expand the font atlas to RGBA32)
+//#define IMGUI_DISABLE_SSE
+
 //---- Avoid multiple STB libraries implementations, or redefine path/filenames to prioritize another version
 // By default the embedded implementations are declared static and not available outside of imgui cpp files.
 //#define IMGUI_STB_TRUETYPE_FILENAME   "my_folder/stb_truetype.h"
@@ -45,6 +56,10 @@
 //#define IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
 //#define IMGUI_DISABLE_STB_RECT_PACK_IMPLEMENTATION
 
+//---- Don't compile stb_truetype nor the font builder using it, when all fonts come from a baked atlas (ImFontAtlas::AddFontsFromMemoryCompressedBakedAtlas()) or from misc/freetype.
+// Without it, ImFontAtlasFlags_DynamicGlyphs and ImFontAtlasFlags_IncrementalFonts have no effect.
+//#define IMGUI_DISABLE_STB_TRUETYPE
+
 //---- Define constructor and implicit cast operators to convert back<>forth from your math types and ImVec2/ImVec4.
 // This will be inlined as part of ImVec2 and ImVec4 class declarations.
 /*
@@ -60,6 +75,11 @@
 //---- Use 32-bit vertex indices (default is 16-bit) to allow meshes with more than 64K vertices. Render function needs to support it.
 //#define ImDrawIdx unsigned int
 
+//---- Use a compact ImDrawVert: 16-bit normalized UV (16 bytes instead of 20), optionally with half-float positions (12 bytes). Render function needs to support it, see ImDrawData::VtxFormat.
+// UV are clamped to the 0.0f..1.0f range (texture wrapping is not supported). Half-float positions lose sub-pixel precision above 1024 and pixel precision above 2048.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+//#define IMGUI_USE_DRAWVERT_HALF_POS
+
 //---- Tip: You can add extra functions within the ImGui:: namespace, here or in your own headers files.
 /*
 namespace ImGui
@@ -156,6 +156,7 @@
         io.MousePos = mouse_pos;
         io.MouseDown[0] = mouse_button_0;
         io.MouseDown[1] = mouse_button_1;
+        // (or queue them from your OS event handlers with io.AddMouseButtonEvent(), io.AddKeyEvent() etc., so presses and releases shorter than a frame are not lost)
 
         // Call NewFrame(), after this point you can use ImGui::* functions anytime
         ImGui::NewFrame();
@@ -706,6 +707,7 @@ static ImGuiWindow*     FindHoveredWindow();
 static ImGuiWindow*     CreateNewWindow(const char* name, ImVec2 size, ImGuiWindowFlags flags);
 static void             CheckStacksSize(ImGuiWindow* window, bool write);
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window);
+static ImVec2           CalcSizeContents(ImGuiWindow* window);
 
 static void             AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
 static void             AddWindowToDrawData(ImVector<ImDrawList*>* out_list, ImGuiWindow* window);
@@ -721,6 +723,10 @@ static void             MarkIniSettingsDirty(ImGuiWindow* window);
 
 static ImRect           GetViewportRect();
 
+static double           ProfilerGetTime();
+static void             ProfilerBeginFrame();
+static void             ProfilerEndFrame();
+
 static void             ClosePopupToLevel(int remaining);
 static ImGuiWindow*     GetFrontMostModalRootWindow();
 
@@ -740,6 +746,7 @@ static void             NavUpdateWindowing();
 static void             NavProcessItem(ImGuiWindow* window, const ImRect& nav_bb, const ImGuiID id);
 
 static void             UpdateMovingWindow();
+static void             UpdateWantNextFrame();
 static void             UpdateManualResize(ImGuiWindow* window, const ImVec2& size_auto_fit, int* border_held, int resize_grip_count, ImU32 resize_grip_col[4]);
 static void             FocusFrontMostActiveWindow(ImGuiWindow* ignore_window);
 }
@@ -760,10 +767,12 @@ static void             ImeSetInputScreenPosFn_DefaultImpl(int x, int y);
 // CreateContext() will automatically set this pointer if it is NULL. Change to a different context by calling ImGui::SetCurrentContext(). 
 // If you use DLL hotreloading you might need to call SetCurrentContext() after reloading code from this file. 
 // ImGui functions are not thread-safe because of this pointer. If you want thread-safety to allow N threads to access N different contexts, you can:
-// - Change this variable to use thread local storage. You may #define GImGui in imconfig.h for that purpose. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
+// - #define IMGUI_USE_THREAD_LOCAL_CONTEXT in imconfig.h. This pointer and the other per-thread state (memory stats, font decompression) use thread local storage, and each thread calls SetCurrentContext() with its own context.
+//   Contexts may share a font atlas (CreateContext(shared_font_atlas)) which must be built before the threads start: it is only read by NewFrame()/Render(), unless it uses ImFontAtlasFlags_DynamicGlyphs. ShowDemoWindow() uses static variables and is not thread-safe.
+// - Change this variable to use your own thread local storage. You may #define GImGui in imconfig.h for that purpose. Future development aim to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
 // - Having multiple instances of the ImGui code compiled inside different namespace (easiest/safest, if you have a finite number of contexts)
 #ifndef GImGui
-ImGuiContext*   GImGui = NULL;
+IM_THREAD_LOCAL ImGuiContext*   GImGui = NULL;
 #endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
@@ -779,8 +788,12 @@ static void    FreeWrapper(void* ptr, void* user_data)        { (void)user_data;
 
 static void*  (*GImAllocatorAllocFunc)(size_t size, void* user_data) = MallocWrapper;
 static void   (*GImAllocatorFreeFunc)(void* ptr, void* user_data) = FreeWrapper;
+static void*  (*GImAllocatorReallocFunc)(void* ptr, size_t old_size, size_t new_size, void* user_data) = NULL;
 static void*    GImAllocatorUserData = NULL;
-static size_t   GImAllocatorActiveAllocationsCount = 0;
+static IM_THREAD_LOCAL size_t         GImAllocatorActiveAllocationsCount = 0;  // Per-thread with IMGUI_USE_THREAD_LOCAL_CONTEXT: counts the allocations made minus the frees made on the current thread
+static IM_THREAD_LOCAL ImGuiMemStats  GImAllocatorStats;             // Frame being accumulated
+static IM_THREAD_LOCAL ImGuiMemStats  GImAllocatorStatsLastFrame;    // Last complete frame, returned by GetMemStats()
+IM_THREAD_LOCAL ImGuiMemOwner         GImAllocatorOwner = ImGuiMemOwner_Other;
 
 //-----------------------------------------------------------------------------
 // User facing structures
@@ -881,6 +894,10 @@ ImGuiIO::ImGuiIO()
     OptMacOSXBehaviors = false;
 #endif
     OptCursorBlink = true;
+    OptMergeDrawLists = false;
+    OptDamageRects = false;
+    OptProfiler = false;
+    OptInputTrickle = true;
 
     // Settings (User Functions)
     GetClipboardTextFn = GetClipboardTextFn_DefaultImpl;   // Platform dependent default implementations
@@ -900,6 +917,10 @@ ImGuiIO::ImGuiIO()
     for (int i = 0; i < IM_ARRAYSIZE(MouseDownDuration); i++) MouseDownDuration[i] = MouseDownDurationPrev[i] = -1.0f;
     for (int i = 0; i < IM_ARRAYSIZE(KeysDownDuration); i++) KeysDownDuration[i]  = KeysDownDurationPrev[i] = -1.0f;
     for (int i = 0; i < IM_ARRAYSIZE(NavInputsDownDuration); i++) NavInputsDownDuration[i] = -1.0f;
+
+    // Output
+    WantNextFrame = true;
+    NextFrameTimeout = 0.0f;
 }
 
 // Pass in translated ASCII characters for text input.
@@ -925,6 +946,60 @@ void ImGuiIO::AddInputCharactersUTF8(const char* utf8_chars)
         AddInputCharacter(wchars[i]);
 }
 
+static void AddInputEvent(ImGuiIO* io, const ImGuiInputEvent& e)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(&g.IO == io && "Can only add events to the io of the current context.");
+    (void)io;
+    g.InputEventsQueue.push_back(e);
+}
+
+void ImGuiIO::AddMousePosEvent(float x, float y, double time)
+{
+    ImGuiInputEvent e(ImGuiInputEventType_MousePos, time);
+    e.Value = ImVec2(x, y);
+    AddInputEvent(this, e);
+}
+
+void ImGuiIO::AddMouseButtonEvent(int button, bool down, double time)
+{
+    IM_ASSERT(button >= 0 && button < IM_ARRAYSIZE(MouseDown));
+    ImGuiInputEvent e(ImGuiInputEventType_MouseButton, time);
+    e.Index = button;
+    e.Down = down;
+    AddInputEvent(this, e);
+}
+
+void ImGuiIO::AddMouseWheelEvent(float wheel_x, float wheel_y, double time)
+{
+    ImGuiInputEvent e(ImGuiInputEventType_MouseWheel, time);
+    e.Value = ImVec2(wheel_x, wheel_y);
+    AddInputEvent(this, e);
+}
+
+void ImGuiIO::AddKeyEvent(int key_index, bool down, double time)
+{
+    IM_ASSERT(key_index >= 0 && key_index < IM_ARRAYSIZE(KeysDown));
+    ImGuiInputEvent e(ImGuiInputEventType_Key, time);
+    e.Index = key_index;
+    e.Down = down;
+    AddInputEvent(this, e);
+}
+
+void ImGuiIO::AddKeyModsEvent(bool ctrl, bool shift, bool alt, bool super, double time)
+{
+    ImGuiInputEvent e(ImGuiInputEventType_KeyMods, time);
+    e.Index = (ctrl ? 1 << 0 : 0) | (shift ? 1 << 1 : 0) | (alt ? 1 << 2 : 0) | (super ? 1 << 3 : 0);
+    AddInputEvent(this, e);
+}
+
+void ImGuiIO::ClearInputEvents()
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(&g.IO == this && "Can only clear events of the io of the current context.");
+    g.InputEventsQueue.resize(0);
+}
+
 //-----------------------------------------------------------------------------
 // HELPERS
 //-----------------------------------------------------------------------------
@@ -1098,18 +1173,42 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 // FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
 ImU32 ImHash(const void* data, int data_size, ImU32 seed)
 {
-    static ImU32 crc32_lut[256] = { 0 };
-    if (!crc32_lut[1])
-    {
-        const ImU32 polynomial = 0xEDB88320;
-        for (ImU32 i = 0; i < 256; i++)
-        {
-            ImU32 crc = i;
-            for (ImU32 j = 0; j < 8; j++)
-                crc = (crc >> 1) ^ (ImU32(-int(crc & 1)) & polynomial);
-            crc32_lut[i] = crc;
-        }
-    }
+    // CRC-32 (polynomial 0xEDB88320) of every byte value. Precomputed so there is no lazy initialization racing between threads.
+    static const ImU32 crc32_lut[256] =
+    {
+        0x00000000, 0x77073096, 0xEE0E612C, 0x990951BA, 0x076DC419, 0x706AF48F, 0xE963A535, 0x9E6495A3,
+        0x0EDB8832, 0x79DCB8A4, 0xE0D5E91E, 0x97D2D988, 0x09B64C2B, 0x7EB17CBD, 0xE7B82D07, 0x90BF1D91,
+        0x1DB71064, 0x6AB020F2, 0xF3B97148, 0x84BE41DE, 0x1ADAD47D, 0x6DDDE4EB, 0xF4D4B551, 0x83D385C7,
+        0x136C9856, 0x646BA8C0, 0xFD62F97A, 0x8A65C9EC, 0x14015C4F, 0x63066CD9, 0xFA0F3D63, 0x8D080DF5,
+        0x3B6E20C8, 0x4C69105E, 0xD56041E4, 0xA2677172, 0x3C03E4D1, 0x4B04D447, 0xD20D85FD, 0xA50AB56B,
+        0x35B5A8FA, 0x42B2986C, 0xDBBBC9D6, 0xACBCF940, 0x32D86CE3, 0x45DF5C75, 0xDCD60DCF, 0xABD13D59,
+        0x26D930AC, 0x51DE003A, 0xC8D75180, 0xBFD06116, 0x21B4F4B5, 0x56B3C423, 0xCFBA9599, 0xB8BDA50F,
+        0x2802B89E, 0x5F058808, 0xC60CD9B2, 0xB10BE924, 0x2F6F7C87, 0x58684C11, 0xC1611DAB, 0xB6662D3D,
+        0x76DC4190, 0x01DB7106, 0x98D220BC, 0xEFD5102A, 0x71B18589, 0x06B6B51F, 0x9FBFE4A5, 0xE8B8D433,
+        0x7807C9A2, 0x0F00F934, 0x9609A88E, 0xE10E9818, 0x7F6A0DBB, 0x086D3D2D, 0x91646C97, 0xE6635C01,
+        0x6B6B51F4, 0x1C6C6162, 0x856530D8, 0xF262004E, 0x6C0695ED, 0x1B01A57B, 0x8208F4C1, 0xF50FC457,
+        0x65B0D9C6, 0x12B7E950, 0x8BBEB8EA, 0xFCB9887C, 0x62DD1DDF, 0x15DA2D49, 0x8CD37CF3, 0xFBD44C65,
+        0x4DB26158, 0x3AB551CE, 0xA3BC0074, 0xD4BB30E2, 0x4ADFA541, 0x3DD895D7, 0xA4D1C46D, 0xD3D6F4FB,
+        0x4369E96A, 0x346ED9FC, 0xAD678846, 0xDA60B8D0, 0x44042D73, 0x33031DE5, 0xAA0A4C5F, 0xDD0D7CC9,
+        0x5005713C, 0x270241AA, 0xBE0B1010, 0xC90C2086, 0x5768B525, 0x206F85B3, 0xB966D409, 0xCE61E49F,
+        0x5EDEF90E, 0x29D9C998, 0xB0D09822, 0xC7D7A8B4, 0x59B33D17, 0x2EB40D81, 0xB7BD5C3B, 0xC0BA6CAD,
+        0xEDB88320, 0x9ABFB3B6, 0x03B6E20C, 0x74B1D29A, 0xEAD54739, 0x9DD277AF, 0x04DB2615, 0x73DC1683,
+        0xE3630B12, 0x94643B84, 0x0D6D6A3E, 0x7A6A5AA8, 0xE40ECF0B, 0x9309FF9D, 0x0A00AE27, 0x7D079EB1,
+        0xF00F9344, 0x8708A3D2, 0x1E01F268, 0x6906C2FE, 0xF762575D, 0x806567CB, 0x196C3671, 0x6E6B06E7,
+        0xFED41B76, 0x89D32BE0, 0x10DA7A5A, 0x67DD4ACC, 0xF9B9DF6F, 0x8EBEEFF9, 0x17B7BE43, 0x60B08ED5,
+        0xD6D6A3E8, 0xA1D1937E, 0x38D8C2C4, 0x4FDFF252, 0xD1BB67F1, 0xA6BC5767, 0x3FB506DD, 0x48B2364B,
+        0xD80D2BDA, 0xAF0A1B4C, 0x36034AF6, 0x41047A60, 0xDF60EFC3, 0xA867DF55, 0x316E8EEF, 0x4669BE79,
+        0xCB61B38C, 0xBC66831A, 0x256FD2A0, 0x5268E236, 0xCC0C7795, 0xBB0B4703, 0x220216B9, 0x5505262F,
+        0xC5BA3BBE, 0xB2BD0B28, 0x2BB45A92, 0x5CB36A04, 0xC2D7FFA7, 0xB5D0CF31, 0x2CD99E8B, 0x5BDEAE1D,
+        0x9B64C2B0, 0xEC63F226, 0x756AA39C, 0x026D930A, 0x9C0906A9, 0xEB0E363F, 0x72076785, 0x05005713,
+        0x95BF4A82, 0xE2B87A14, 0x7BB12BAE, 0x0CB61B38, 0x92D28E9B, 0xE5D5BE0D, 0x7CDCEFB7, 0x0BDBDF21,
+        0x86D3D2D4, 0xF1D4E242, 0x68DDB3F8, 0x1FDA836E, 0x81BE16CD, 0xF6B9265B, 0x6FB077E1, 0x18B74777,
+        0x88085AE6, 0xFF0F6A70, 0x66063BCA, 0x11010B5C, 0x8F659EFF, 0xF862AE69, 0x616BFFD3, 0x166CCF45,
+        0xA00AE278, 0xD70DD2EE, 0x4E048354, 0x3903B3C2, 0xA7672661, 0xD06016F7, 0x4969474D, 0x3E6E77DB,
+        0xAED16A4A, 0xD9D65ADC, 0x40DF0B66, 0x37D83BF0, 0xA9BCAE53, 0xDEBB9EC5, 0x47B2CF7F, 0x30B5FFE9,
+        0xBDBDF21C, 0xCABAC28A, 0x53B39330, 0x24B4A3A6, 0xBAD03605, 0xCDD70693, 0x54DE5729, 0x23D967BF,
+        0xB3667A2E, 0xC4614AB8, 0x5D681B02, 0x2A6F2B94, 0xB40BBE37, 0xC30C8EA1, 0x5A05DF1B, 0x2D02EF8D
+    };
 
     seed = ~seed;
     ImU32 crc = seed;
@@ -1554,7 +1653,10 @@ int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
     ImVector<Pair>::iterator it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
+    {
+        ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Storage);
         it = Data.insert(it, Pair(key, default_val));
+    }
     return &it->val_i;
 }
 
@@ -1567,7 +1669,10 @@ float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
     ImVector<Pair>::iterator it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
+    {
+        ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Storage);
         it = Data.insert(it, Pair(key, default_val));
+    }
     return &it->val_f;
 }
 
@@ -1575,7 +1680,10 @@ void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
     ImVector<Pair>::iterator it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
+    {
+        ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Storage);
         it = Data.insert(it, Pair(key, default_val));
+    }
     return &it->val_p;
 }
 
@@ -1585,6 +1693,7 @@ void ImGuiStorage::SetInt(ImGuiID key, int val)
     ImVector<Pair>::iterator it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
     {
+        ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Storage);
         Data.insert(it, Pair(key, val));
         return;
     }
@@ -1601,6 +1710,7 @@ void ImGuiStorage::SetFloat(ImGuiID key, float val)
     ImVector<Pair>::iterator it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
     {
+        ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Storage);
         Data.insert(it, Pair(key, val));
         return;
     }
@@ -1612,6 +1722,7 @@ void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
     ImVector<Pair>::iterator it = LowerBound(Data, key);
     if (it == Data.end() || it->key != key)
     {
+        ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Storage);
         Data.insert(it, Pair(key, val));
         return;
     }
@@ -2573,16 +2684,121 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 
 //-----------------------------------------------------------------------------
 
+// Every block is preceded by a header recording its size and owner, for ImGuiMemStats.
+// Two pointer-sized fields, so we preserve the alignment provided by malloc().
+struct ImGuiMemBlockHeader
+{
+    size_t      Size;
+    size_t      Owner;      // ImGuiMemOwner in the low 8 bits, MEM_BLOCK_MAGIC above
+};
+
+static const size_t MEM_BLOCK_MAGIC = 0x1A110C00;
+
+static ImGuiMemBlockHeader* MemGetBlockHeader(void* ptr)
+{
+    ImGuiMemBlockHeader* header = (ImGuiMemBlockHeader*)ptr - 1;
+    IM_ASSERT((header->Owner & ~(size_t)0xFF) == MEM_BLOCK_MAGIC && "Block not allocated with ImGui::MemAlloc(), or already freed. Data owned by ImGui (e.g. TTF data of AddFontFromMemoryTTF()) must be allocated with ImGui::MemAlloc().");
+    return header;
+}
+
+static void MemStatsOnAlloc(size_t sz, ImGuiMemOwner owner)
+{
+    ImGuiMemStats& stats = GImAllocatorStats;
+    stats.AllocCount++;
+    stats.AllocCountByOwner[owner]++;
+    stats.BytesAllocated += sz;
+    stats.BytesLive += sz;
+    stats.BytesLiveByOwner[owner] += sz;
+    if (stats.BytesPeak < stats.BytesLive)
+        stats.BytesPeak = stats.BytesLive;
+}
+
+static void MemStatsOnFree(size_t sz, ImGuiMemOwner owner)
+{
+    ImGuiMemStats& stats = GImAllocatorStats;
+    stats.FreeCount++;
+    stats.BytesFreed += sz;
+    stats.BytesLive -= sz;
+    stats.BytesLiveByOwner[owner] -= sz;
+}
+
 void* ImGui::MemAlloc(size_t sz)
 {
     GImAllocatorActiveAllocationsCount++;
-    return GImAllocatorAllocFunc(sz, GImAllocatorUserData);
+    ImGuiMemBlockHeader* header = (ImGuiMemBlockHeader*)GImAllocatorAllocFunc(sizeof(ImGuiMemBlockHeader) + sz, GImAllocatorUserData);
+    if (header == NULL)
+        return NULL;
+    header->Size = sz;
+    header->Owner = (size_t)GImAllocatorOwner | MEM_BLOCK_MAGIC;
+    MemStatsOnAlloc(sz, GImAllocatorOwner);
+    return header + 1;
 }
 
 void ImGui::MemFree(void* ptr)
 {
-    if (ptr) GImAllocatorActiveAllocationsCount--;
-    return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
+    if (ptr == NULL)
+        return;
+    GImAllocatorActiveAllocationsCount--;
+    ImGuiMemBlockHeader* header = MemGetBlockHeader(ptr);
+    MemStatsOnFree(header->Size, (ImGuiMemOwner)(header->Owner & 0xFF));
+    header->Owner = 0;
+    GImAllocatorFreeFunc(header, GImAllocatorUserData);
+}
+
+void* ImGui::MemRealloc(void* ptr, size_t old_size, size_t new_size)
+{
+    if (ptr == NULL)
+        return MemAlloc(new_size);
+
+    // The new block keeps the owner of the old one (e.g. a vector growing outside of the scope of its owner)
+    ImGuiMemBlockHeader* header = MemGetBlockHeader(ptr);
+    const size_t block_size = header->Size;
+    const ImGuiMemOwner owner = (ImGuiMemOwner)(header->Owner & 0xFF);
+    IM_ASSERT(old_size <= block_size);
+    if (GImAllocatorReallocFunc)
+    {
+        ImGuiMemBlockHeader* new_header = (ImGuiMemBlockHeader*)GImAllocatorReallocFunc(header, sizeof(ImGuiMemBlockHeader) + old_size, sizeof(ImGuiMemBlockHeader) + new_size, GImAllocatorUserData);
+        if (new_header == NULL)
+            return NULL;
+        MemStatsOnFree(block_size, owner);
+        MemStatsOnAlloc(new_size, owner);
+        new_header->Size = new_size;
+        return new_header + 1;
+    }
+    ImGuiMemOwner backup_owner = GImAllocatorOwner;
+    GImAllocatorOwner = owner;
+    void* new_ptr = MemAlloc(new_size);
+    GImAllocatorOwner = backup_owner;
+    memcpy(new_ptr, ptr, old_size);
+    MemFree(ptr);
+    return new_ptr;
+}
+
+void* ImGui::MemAllocThreadSafe(size_t sz)
+{
+    return GImAllocatorAllocFunc(sz, GImAllocatorUserData);
+}
+
+void ImGui::MemFreeThreadSafe(void* ptr)
+{
+    if (ptr)
+        GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
+}
+
+const ImGuiMemStats& ImGui::GetMemStats()
+{
+    return GImAllocatorStatsLastFrame;
+}
+
+// Called by NewFrame()
+static void MemStatsNewFrame()
+{
+    ImGuiMemStats& stats = GImAllocatorStats;
+    GImAllocatorStatsLastFrame = stats;
+    stats.AllocCount = stats.FreeCount = 0;
+    stats.BytesAllocated = stats.BytesFreed = 0;
+    stats.BytesPeak = stats.BytesLive;
+    memset(stats.AllocCountByOwner, 0, sizeof(stats.AllocCountByOwner));
 }
 
 const char* ImGui::GetClipboardText()
@@ -2617,10 +2833,11 @@ void ImGui::SetCurrentContext(ImGuiContext* ctx)
 #endif
 }
 
-void ImGui::SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void(*free_func)(void* ptr, void* user_data), void* user_data)
+void ImGui::SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void(*free_func)(void* ptr, void* user_data), void* user_data, void* (*realloc_func)(void* ptr, size_t old_size, size_t new_size, void* user_data))
 {
     GImAllocatorAllocFunc = alloc_func;
     GImAllocatorFreeFunc = free_func;
+    GImAllocatorReallocFunc = realloc_func;
     GImAllocatorUserData = user_data;
 }
 
@@ -2672,6 +2889,19 @@ int ImGui::GetFrameCount()
     return GImGui->FrameCount;
 }
 
+void ImGui::RequestFrame(float delay)
+{
+    ImGuiContext& g = *GImGui;
+    delay = ImMax(delay, 0.0f);
+    g.RequestFrameDelay = ImMin(g.RequestFrameDelay, delay);
+    if (g.FrameCountEnded == g.FrameCount)
+    {
+        // Called after EndFrame(): update the outputs directly
+        g.IO.NextFrameTimeout = ImMin(g.IO.NextFrameTimeout, delay);
+        g.IO.WantNextFrame |= (g.IO.NextFrameTimeout <= 0.0f);
+    }
+}
+
 ImDrawList* ImGui::GetOverlayDrawList()
 {
     return &GImGui->OverlayDrawList;
@@ -3272,6 +3502,166 @@ static void ImGui::UpdateMovingWindow()
     }
 }
 
+//-----------------------------------------------------------------------------
+// Profiler
+//-----------------------------------------------------------------------------
+
+// Start recording a frame in ProfilerFrames[ProfilerFramesHead]
+static void ProfilerBeginFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfilerFrame& frame = g.ProfilerFrames[g.ProfilerFramesHead];
+    frame.Zones.resize(0);
+    frame.FrameCount = g.FrameCount + 1;
+    frame.DurationMs = 0.0f;
+    g.ProfilerZoneStack.resize(0);
+    g.ProfilerFrameActive = true;
+    g.ProfilerFrameHasNewFrame = false;
+    g.ProfilerFrameStartTime = ProfilerGetTime();
+}
+
+// Close the zones left open and commit the frame to the ring buffer
+static void ProfilerEndFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiProfilerFrame& frame = g.ProfilerFrames[g.ProfilerFramesHead];
+    const float end_ms = (float)((ProfilerGetTime() - g.ProfilerFrameStartTime) * 1000.0);
+    while (g.ProfilerZoneStack.Size > 0)
+    {
+        frame.Zones[g.ProfilerZoneStack.back()].EndMs = end_ms;
+        g.ProfilerZoneStack.pop_back();
+    }
+    frame.DurationMs = end_ms;
+    g.ProfilerFrameActive = false;
+    g.ProfilerFramesHead = (g.ProfilerFramesHead + 1) % IM_ARRAYSIZE(g.ProfilerFrames);
+    g.ProfilerFramesCount = ImMin(g.ProfilerFramesCount + 1, IM_ARRAYSIZE(g.ProfilerFrames));
+}
+
+void ImGui::ProfilerPushZone(const char* name)
+{
+#ifndef IMGUI_DISABLE_PROFILER
+    ImGuiContext* ctx = GImGui;
+    if (ctx == NULL || !ctx->IO.OptProfiler)
+        return;
+    ImGuiContext& g = *ctx;
+    if (!g.ProfilerFrameActive)
+        ProfilerBeginFrame();
+    ImGuiProfilerFrame& frame = g.ProfilerFrames[g.ProfilerFramesHead];
+    ImGuiProfilerZone zone;
+    zone.Name = name;
+    zone.Depth = g.ProfilerZoneStack.Size;
+    zone.StartMs = zone.EndMs = (float)((ProfilerGetTime() - g.ProfilerFrameStartTime) * 1000.0);
+    g.ProfilerZoneStack.push_back(frame.Zones.Size);
+    frame.Zones.push_back(zone);
+#else
+    (void)name;
+#endif
+}
+
+void ImGui::ProfilerPopZone()
+{
+#ifndef IMGUI_DISABLE_PROFILER
+    // Don't test io.OptProfiler, so zones opened before the profiler got disabled are closed
+    ImGuiContext* ctx = GImGui;
+    if (ctx == NULL || !ctx->ProfilerFrameActive || ctx->ProfilerZoneStack.Size == 0)
+        return;
+    ImGuiContext& g = *ctx;
+    ImGuiProfilerFrame& frame = g.ProfilerFrames[g.ProfilerFramesHead];
+    frame.Zones[g.ProfilerZoneStack.back()].EndMs = (float)((ProfilerGetTime() - g.ProfilerFrameStartTime) * 1000.0);
+    g.ProfilerZoneStack.pop_back();
+#endif
+}
+
+int ImGui::GetProfilerFramesCount()
+{
+    return GImGui->ProfilerFramesCount;
+}
+
+const ImGuiProfilerFrame* ImGui::GetProfilerFrame(int n)
+{
+    ImGuiContext& g = *GImGui;
+    if (n < 0 || n >= g.ProfilerFramesCount)
+        return NULL;
+    const int frames_size = IM_ARRAYSIZE(g.ProfilerFrames);
+    return &g.ProfilerFrames[(g.ProfilerFramesHead - 1 - n + frames_size) % frames_size];
+}
+
+// Apply the queued input events to io.MousePos, io.MouseDown[] etc.
+// With io.OptInputTrickle, stop at the first event which would hide a change already applied this frame (e.g. the release of a button pressed this frame): it is kept for the next frame.
+static void UpdateInputEvents()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    const bool trickle = io.OptInputTrickle;
+    bool mouse_moved = false, mouse_wheeled = false, key_mods_changed = false;
+    int mouse_button_changed = 0;
+    ImU32 keys_changed[IM_ARRAYSIZE(io.KeysDown) / 32] = {};
+
+    int event_n = 0;
+    for (; event_n < g.InputEventsQueue.Size; event_n++)
+    {
+        const ImGuiInputEvent& e = g.InputEventsQueue[event_n];
+        if (e.Type == ImGuiInputEventType_MousePos)
+        {
+            // Keep the mouse still over a button press/release or wheel applied this frame
+            if (trickle && (mouse_button_changed != 0 || mouse_wheeled))
+                break;
+            io.MousePos = e.Value;
+            mouse_moved = true;
+        }
+        else if (e.Type == ImGuiInputEventType_MouseButton)
+        {
+            const int button_mask = 1 << e.Index;
+            if (trickle && ((mouse_button_changed & button_mask) || mouse_wheeled))
+                break;
+            if (io.MouseDown[e.Index] == e.Down)
+                continue;
+            io.MouseDown[e.Index] = e.Down;
+            if (e.Down)
+                g.InputEventsMouseDownTime[e.Index] = e.Time;
+            mouse_button_changed |= button_mask;
+        }
+        else if (e.Type == ImGuiInputEventType_MouseWheel)
+        {
+            if (trickle && (mouse_moved || mouse_button_changed != 0))
+                break;
+            io.MouseWheelH += e.Value.x;
+            io.MouseWheel += e.Value.y;
+            mouse_wheeled = true;
+        }
+        else if (e.Type == ImGuiInputEventType_Key)
+        {
+            const ImU32 key_mask = (ImU32)1 << (e.Index & 31);
+            if (trickle && ((keys_changed[e.Index >> 5] & key_mask) || mouse_button_changed != 0))
+                break;
+            if (io.KeysDown[e.Index] == e.Down)
+                continue;
+            io.KeysDown[e.Index] = e.Down;
+            keys_changed[e.Index >> 5] |= key_mask;
+        }
+        else if (e.Type == ImGuiInputEventType_KeyMods)
+        {
+            const bool ctrl = (e.Index & (1 << 0)) != 0, shift = (e.Index & (1 << 1)) != 0, alt = (e.Index & (1 << 2)) != 0, super = (e.Index & (1 << 3)) != 0;
+            if (io.KeyCtrl == ctrl && io.KeyShift == shift && io.KeyAlt == alt && io.KeySuper == super)
+                continue;
+            if (trickle && (key_mods_changed || mouse_button_changed != 0))
+                break;
+            io.KeyCtrl = ctrl;
+            io.KeyShift = shift;
+            io.KeyAlt = alt;
+            io.KeySuper = super;
+            key_mods_changed = true;
+        }
+    }
+
+    // Remove the applied events
+    if (event_n > 0)
+    {
+        memmove(g.InputEventsQueue.Data, g.InputEventsQueue.Data + event_n, (size_t)(g.InputEventsQueue.Size - event_n) * sizeof(ImGuiInputEvent));
+        g.InputEventsQueue.resize(g.InputEventsQueue.Size - event_n);
+    }
+}
+
 void ImGui::NewFrame()
 {
     IM_ASSERT(GImGui != NULL && "No current context. Did you call ImGui::CreateContext() or ImGui::SetCurrentContext()?");
@@ -3294,6 +3684,22 @@ void ImGui::NewFrame()
     if (g.IO.ConfigFlags & ImGuiConfigFlags_NavEnableKeyboard)
         IM_ASSERT(g.IO.KeyMap[ImGuiKey_Space] != -1 && "ImGuiKey_Space is not mapped, required for keyboard navigation.");
 
+    // Close allocation statistics of the previous frame
+    MemStatsNewFrame();
+
+    // Start recording CPU timings (a frame may already have been started by zones recorded since the last Render(), e.g. font atlas building)
+    if (g.ProfilerFrameActive && g.ProfilerFrameHasNewFrame)
+        ProfilerEndFrame(); // Render() wasn't called
+#ifndef IMGUI_DISABLE_PROFILER
+    if (g.IO.OptProfiler)
+    {
+        if (!g.ProfilerFrameActive)
+            ProfilerBeginFrame();
+        g.ProfilerFrameHasNewFrame = true;
+    }
+#endif
+    ProfilerPushZone("NewFrame");
+
     // Load settings on first frame
     if (!g.SettingsLoaded)
     {
@@ -3307,6 +3713,10 @@ void ImGui::NewFrame()
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
 
+    // Grow the font atlas texture if glyphs didn't fit during the last frame (ImFontAtlasFlags_DynamicGlyphs). This changes the texture coordinates.
+    if (g.IO.Fonts->DynamicData)
+        ImFontAtlasBuildDynamicNewFrame(g.IO.Fonts);
+
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
     g.DrawListSharedData.ClipRectFullscreen = ImVec4(0.0f, 0.0f, g.IO.DisplaySize.x, g.IO.DisplaySize.y);
@@ -3340,20 +3750,26 @@ void ImGui::NewFrame()
     if (g.DragDropActive && g.DragDropPayload.DataFrameCount + 1 < g.FrameCount)
     {
         ClearDragDrop();
-        g.DragDropPayloadBufHeap.clear();
+        g.DragDropPayloadBufHeap.resize(0);
         memset(&g.DragDropPayloadBufLocal, 0, sizeof(g.DragDropPayloadBufLocal));
     }
     g.DragDropAcceptIdPrev = g.DragDropAcceptIdCurr;
     g.DragDropAcceptIdCurr = 0;
     g.DragDropAcceptIdCurrRectSurface = FLT_MAX;
 
+    // Apply queued input events
+    if (g.InputEventsQueue.Size > 0)
+        UpdateInputEvents();
+
     // Update keyboard input state
     memcpy(g.IO.KeysDownDurationPrev, g.IO.KeysDownDuration, sizeof(g.IO.KeysDownDuration));
     for (int i = 0; i < IM_ARRAYSIZE(g.IO.KeysDown); i++)
         g.IO.KeysDownDuration[i] = g.IO.KeysDown[i] ? (g.IO.KeysDownDuration[i] < 0.0f ? 0.0f : g.IO.KeysDownDuration[i] + g.IO.DeltaTime) : -1.0f;
 
     // Update gamepad/keyboard directional navigation
+    ProfilerPushZone("NavUpdate");
     NavUpdate();
+    ProfilerPopZone();
 
     // Update mouse input state
     // If mouse just appeared or disappeared (usually denoted by -FLT_MAX component, but in reality we test for -256000.0f) we cancel out movement in MouseDelta
@@ -3374,15 +3790,21 @@ void ImGui::NewFrame()
         g.IO.MouseDoubleClicked[i] = false;
         if (g.IO.MouseClicked[i])
         {
-            if (g.Time - g.IO.MouseClickedTime[i] < g.IO.MouseDoubleClickTime)
+            // Clicks from timestamped events are measured with the back-end clock, which stays accurate when the events were spread over several frames
+            const double click_event_time = g.InputEventsMouseDownTime[i];
+            const bool click_event_timed = (click_event_time >= 0.0 && g.InputEventsMouseClickedTime[i] >= 0.0);
+            const float click_interval = click_event_timed ? (float)(click_event_time - g.InputEventsMouseClickedTime[i]) : (g.Time - g.IO.MouseClickedTime[i]);
+            if (click_interval < g.IO.MouseDoubleClickTime)
             {
                 if (ImLengthSqr(g.IO.MousePos - g.IO.MouseClickedPos[i]) < g.IO.MouseDoubleClickMaxDist * g.IO.MouseDoubleClickMaxDist)
                     g.IO.MouseDoubleClicked[i] = true;
                 g.IO.MouseClickedTime[i] = -FLT_MAX;    // so the third click isn't turned into a double-click
+                g.InputEventsMouseClickedTime[i] = -1.0;
             }
             else
             {
                 g.IO.MouseClickedTime[i] = g.Time;
+                g.InputEventsMouseClickedTime[i] = click_event_time;
             }
             g.IO.MouseClickedPos[i] = g.IO.MousePos;
             g.IO.MouseDragMaxDistanceAbs[i] = ImVec2(0.0f, 0.0f);
@@ -3397,6 +3819,7 @@ void ImGui::NewFrame()
         }
         if (g.IO.MouseClicked[i]) // Clicking any mouse button reactivate mouse hovering which may have been deactivated by gamepad/keyboard navigation
             g.NavDisableMouseHover = false;
+        g.InputEventsMouseDownTime[i] = -1.0;
     }
 
     // Calculate frame-rate for the user, as a purely luxurious feature
@@ -3464,6 +3887,7 @@ void ImGui::NewFrame()
     g.IO.WantTextInput = (g.WantTextInputNextFrame != -1) ? (g.WantTextInputNextFrame != 0) : 0;
     g.MouseCursor = ImGuiMouseCursor_Arrow;
     g.WantCaptureMouseNextFrame = g.WantCaptureKeyboardNextFrame = g.WantTextInputNextFrame = -1;
+    g.RequestFrameDelay = FLT_MAX;
     g.OsImePosRequest = ImVec2(1.0f, 1.0f); // OS Input Method Editor showing on top-left of our window by default
 
     // If mouse was first clicked outside of ImGui bounds we also cancel out hovering.
@@ -3542,6 +3966,7 @@ void ImGui::NewFrame()
     g.CurrentWindowStack.resize(0);
     g.CurrentPopupStack.resize(0);
     ClosePopupsOverWindow(g.NavWindow);
+    ProfilerPopZone();
 
     // Create implicit window - we will only render it if the user has added something to it.
     // We don't use "Debug" to avoid colliding with user trying to create a "Debug" window with custom flags.
@@ -3658,6 +4083,18 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.CurrentPopupStack.clear();
     g.DrawDataBuilder.ClearFreeMemory();
     g.OverlayDrawList.ClearFreeMemory();
+    for (int i = 0; i < g.MergedDrawLists.Size; i++)
+        IM_DELETE(g.MergedDrawLists[i]);
+    g.MergedDrawLists.clear();
+    g.InputEventsQueue.clear();
+    g.DamageDrawLists.clear();
+    g.DamageDrawListsTemp.clear();
+    g.DamageRects.clear();
+    for (int i = 0; i < IM_ARRAYSIZE(g.ProfilerFrames); i++)
+        g.ProfilerFrames[i].Zones.clear();
+    g.ProfilerFramesCount = 0;
+    g.ProfilerFrameActive = false;
+    g.ProfilerZoneStack.clear();
     g.PrivateClipboard.clear();
     g.InputTextState.Text.clear();
     g.InputTextState.InitialText.clear();
@@ -3919,8 +4356,120 @@ void ImDrawDataBuilder::FlattenIntoSingleLayer()
     }
 }
 
+// Return true if all vertices referenced by the command are within its clipping rectangle (so the command can use any larger clipping rectangle without visible change)
+static bool IsDrawCmdWithinClipRect(const ImDrawVert* vtx_buffer, const ImDrawIdx* idx_buffer, const ImDrawCmd* cmd)
+{
+    const ImVec4& cr = cmd->ClipRect;
+    for (unsigned int i = 0; i < cmd->ElemCount; i++)
+    {
+        const ImVec2 pos = vtx_buffer[idx_buffer[i]].pos;
+        if (pos.x < cr.x || pos.y < cr.y || pos.x > cr.z || pos.y > cr.w)
+            return false;
+    }
+    return true;
+}
+
+// Optional pass (io.OptMergeDrawLists): copy consecutive draw lists into a few merged lists owned by the context, joining the last command of a list with the first command of the next one whenever possible.
+// Two commands are joined when they share a texture and either have the same clipping rectangle, either both have all their vertices within their own clipping rectangle (then the union of both rectangles is used).
+// Draw order is unchanged. Lists using callbacks are left untouched as the callback may rely on its parent list.
+static void MergeDrawLists(ImVector<ImDrawList*>* draw_lists)
+{
+    ImGuiContext& g = *GImGui;
+    int merged_lists_used = 0;
+    int out_n = 0;
+    ImDrawList* dst = NULL;
+    unsigned int dst_elem_count = 0;    // Indices covered by dst->CmdBuffer so far
+    int dst_last_cmd_within_clip = -1;  // Lazily evaluated: -1 unknown, 0 no, 1 yes
+    for (int src_n = 0; src_n < draw_lists->Size; src_n++)
+    {
+        ImDrawList* src = draw_lists->Data[src_n];
+        bool src_has_callbacks = false;
+        for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size && !src_has_callbacks; cmd_n++)
+            src_has_callbacks = (src->CmdBuffer.Data[cmd_n].UserCallback != NULL);
+        if (src_has_callbacks)
+        {
+            draw_lists->Data[out_n++] = src;
+            dst = NULL;
+            continue;
+        }
+
+        // Start a new merged list if needed (we can't go past 64K vertices with 16-bit indices)
+        if (dst != NULL && sizeof(ImDrawIdx) == 2 && dst->VtxBuffer.Size + src->VtxBuffer.Size > (1 << 16))
+            dst = NULL;
+        if (dst == NULL)
+        {
+            if (merged_lists_used == g.MergedDrawLists.Size)
+            {
+                ImDrawList* new_list = IM_NEW(ImDrawList)(&g.DrawListSharedData);
+                new_list->_OwnerName = "##MergedDrawList";
+                g.MergedDrawLists.push_back(new_list);
+            }
+            dst = g.MergedDrawLists[merged_lists_used++];
+            dst->CmdBuffer.resize(0);
+            dst->IdxBuffer.resize(0);
+            dst->VtxBuffer.resize(0);
+            dst_elem_count = 0;
+            draw_lists->Data[out_n++] = dst;
+        }
+
+        // Append vertices and indices
+        const unsigned int vtx_offset = (unsigned int)dst->VtxBuffer.Size;
+        const int idx_offset = dst->IdxBuffer.Size;
+        dst->VtxBuffer.resize(dst->VtxBuffer.Size + src->VtxBuffer.Size);
+        memcpy(dst->VtxBuffer.Data + vtx_offset, src->VtxBuffer.Data, (size_t)src->VtxBuffer.Size * sizeof(ImDrawVert));
+        dst->IdxBuffer.resize(dst->IdxBuffer.Size + src->IdxBuffer.Size);
+        ImDrawIdx* dst_idx = dst->IdxBuffer.Data + idx_offset;
+        for (int i = 0; i < src->IdxBuffer.Size; i++)
+            dst_idx[i] = (ImDrawIdx)(src->IdxBuffer.Data[i] + vtx_offset);
+
+        // Append commands
+        const ImDrawIdx* src_idx = src->IdxBuffer.Data;
+        for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd* src_cmd = &src->CmdBuffer.Data[cmd_n];
+            if (src_cmd->ElemCount == 0)
+                continue;
+            ImDrawCmd* dst_cmd = dst->CmdBuffer.Size > 0 ? &dst->CmdBuffer.back() : NULL;
+            bool merged = false;
+            if (dst_cmd != NULL && dst_cmd->TextureId == src_cmd->TextureId)
+            {
+                if (memcmp(&dst_cmd->ClipRect, &src_cmd->ClipRect, sizeof(ImVec4)) == 0)
+                {
+                    if (dst_last_cmd_within_clip == 1 && !IsDrawCmdWithinClipRect(src->VtxBuffer.Data, src_idx, src_cmd))
+                        dst_last_cmd_within_clip = 0;
+                    merged = true;
+                }
+                else
+                {
+                    if (dst_last_cmd_within_clip == -1)
+                        dst_last_cmd_within_clip = IsDrawCmdWithinClipRect(dst->VtxBuffer.Data, dst->IdxBuffer.Data + dst_elem_count - dst_cmd->ElemCount, dst_cmd) ? 1 : 0;
+                    if (dst_last_cmd_within_clip == 1 && IsDrawCmdWithinClipRect(src->VtxBuffer.Data, src_idx, src_cmd))
+                    {
+                        const ImVec4& cr = src_cmd->ClipRect;
+                        dst_cmd->ClipRect = ImVec4(ImMin(dst_cmd->ClipRect.x, cr.x), ImMin(dst_cmd->ClipRect.y, cr.y), ImMax(dst_cmd->ClipRect.z, cr.z), ImMax(dst_cmd->ClipRect.w, cr.w));
+                        merged = true;
+                    }
+                }
+            }
+            if (merged)
+            {
+                dst_cmd->ElemCount += src_cmd->ElemCount;
+            }
+            else
+            {
+                dst->CmdBuffer.push_back(*src_cmd);
+                dst_last_cmd_within_clip = -1;
+            }
+            dst_elem_count += src_cmd->ElemCount;
+            src_idx += src_cmd->ElemCount;
+        }
+    }
+    draw_lists->resize(out_n);
+}
+
 static void SetupDrawData(ImVector<ImDrawList*>* draw_lists, ImDrawData* out_draw_data)
 {
+    ImGuiContext& g = *GImGui;
     out_draw_data->Valid = true;
     out_draw_data->CmdLists = (draw_lists->Size > 0) ? draw_lists->Data : NULL;
     out_draw_data->CmdListsCount = draw_lists->Size;
@@ -3930,6 +4479,120 @@ static void SetupDrawData(ImVector<ImDrawList*>* draw_lists, ImDrawData* out_dra
         out_draw_data->TotalVtxCount += draw_lists->Data[n]->VtxBuffer.Size;
         out_draw_data->TotalIdxCount += draw_lists->Data[n]->IdxBuffer.Size;
     }
+    out_draw_data->DamageRects = (g.DamageRects.Size > 0) ? g.DamageRects.Data : NULL;
+    out_draw_data->DamageRectsCount = g.DamageRects.Size;
+}
+
+// Hash the contents of a draw list and compute the pixels it may touch, rounded outward to integer coordinates
+static ImU32 HashDrawListForDamage(const ImDrawList* draw_list, ImRect* out_bounds)
+{
+    ImRect vtx_bounds;
+    for (int n = 0; n < draw_list->VtxBuffer.Size; n++)
+        vtx_bounds.Add(draw_list->VtxBuffer.Data[n].pos);
+    ImRect clip_bounds;
+    ImU32 hash = ImHash(draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert));
+    hash = ImHash(draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), hash);
+    for (int n = 0; n < draw_list->CmdBuffer.Size; n++)
+    {
+        // Hash fields one by one, the structure may contain uninitialized padding
+        const ImDrawCmd& cmd = draw_list->CmdBuffer.Data[n];
+        hash = ImHash(&cmd.ElemCount, sizeof(cmd.ElemCount), hash);
+        hash = ImHash(&cmd.ClipRect, sizeof(cmd.ClipRect), hash);
+        hash = ImHash(&cmd.TextureId, sizeof(cmd.TextureId), hash);
+        hash = ImHash(&cmd.UserCallback, sizeof(cmd.UserCallback), hash);
+        hash = ImHash(&cmd.UserCallbackData, sizeof(cmd.UserCallbackData), hash);
+        clip_bounds.Add(ImRect(cmd.ClipRect));
+    }
+    vtx_bounds.ClipWith(clip_bounds);
+    *out_bounds = ImRect(floorf(vtx_bounds.Min.x), floorf(vtx_bounds.Min.y), ceilf(vtx_bounds.Max.x), ceilf(vtx_bounds.Max.y));
+    return hash;
+}
+
+static void AddDamageRect(ImVector<ImVec4>* out_rects, ImRect r, const ImRect& display_rect)
+{
+    r.ClipWith(display_rect);
+    if (r.Min.x >= r.Max.x || r.Min.y >= r.Max.y)
+        return;
+    out_rects->push_back(ImVec4(r.Min.x, r.Min.y, r.Max.x, r.Max.y));
+}
+
+// Optional pass (io.OptDamageRects): compare the draw lists with the ones of the previous frame to find the regions of the display which changed.
+// A draw list damages its old and new bounds when its contents or bounds changed, or when it moved in the draw order relative to other lists (e.g. focused window brought to front).
+// Lists are identified by their address. Changes in the contents of textures are not detected.
+static void UpdateDamageRects(const ImVector<ImDrawList*>* draw_lists)
+{
+    ImGuiContext& g = *GImGui;
+    const ImRect display_rect(ImVec2(0.0f, 0.0f), g.IO.DisplaySize);
+    g.DamageRects.resize(0);
+    if (!g.IO.OptDamageRects)
+    {
+        g.DamageDrawLists.resize(0);
+        g.DamageDisplaySize = ImVec2(-1.0f, -1.0f);
+        AddDamageRect(&g.DamageRects, display_rect, display_rect);
+        return;
+    }
+
+    ImVector<ImGuiDrawListDamageInfo>& prev_lists = g.DamageDrawLists;
+    ImVector<ImGuiDrawListDamageInfo>& curr_lists = g.DamageDrawListsTemp;
+    curr_lists.resize(draw_lists->Size);
+    const bool full_damage = (g.DamageDisplaySize.x != g.IO.DisplaySize.x || g.DamageDisplaySize.y != g.IO.DisplaySize.y);
+    g.DamageDisplaySize = g.IO.DisplaySize;
+    if (full_damage)
+        AddDamageRect(&g.DamageRects, display_rect, display_rect);
+
+    // Previous frame lists are marked by clearing their DrawList pointer when they are matched
+    int prev_max_matched_idx = -1;
+    for (int curr_idx = 0; curr_idx < draw_lists->Size; curr_idx++)
+    {
+        ImGuiDrawListDamageInfo& curr = curr_lists[curr_idx];
+        curr.DrawList = draw_lists->Data[curr_idx];
+        curr.Hash = HashDrawListForDamage(curr.DrawList, &curr.Bounds);
+        if (full_damage)
+            continue;
+        int prev_idx = 0;
+        while (prev_idx < prev_lists.Size && prev_lists[prev_idx].DrawList != curr.DrawList)
+            prev_idx++;
+        if (prev_idx == prev_lists.Size)
+        {
+            AddDamageRect(&g.DamageRects, curr.Bounds, display_rect);
+            continue;
+        }
+        ImGuiDrawListDamageInfo& prev = prev_lists[prev_idx];
+        prev.DrawList = NULL;
+
+        // Lists whose previous index is increasing keep their relative order. Any other list is damaged.
+        const bool order_changed = (prev_idx < prev_max_matched_idx);
+        if (!order_changed)
+            prev_max_matched_idx = prev_idx;
+        if (order_changed || prev.Hash != curr.Hash || memcmp(&prev.Bounds, &curr.Bounds, sizeof(ImRect)) != 0)
+        {
+            AddDamageRect(&g.DamageRects, prev.Bounds, display_rect);
+            AddDamageRect(&g.DamageRects, curr.Bounds, display_rect);
+        }
+    }
+    if (!full_damage)
+        for (int prev_idx = 0; prev_idx < prev_lists.Size; prev_idx++)
+            if (prev_lists[prev_idx].DrawList != NULL)
+                AddDamageRect(&g.DamageRects, prev_lists[prev_idx].Bounds, display_rect);
+    prev_lists.swap(curr_lists);
+
+    // Merge overlapping rectangles until they are all disjoint, so renderers never process a pixel twice
+    for (bool merged = true; merged; )
+    {
+        merged = false;
+        for (int i = 0; i < g.DamageRects.Size; i++)
+            for (int j = g.DamageRects.Size - 1; j > i; j--)
+            {
+                ImRect ri(g.DamageRects[i]);
+                const ImRect rj(g.DamageRects[j]);
+                if (!ri.Overlaps(rj))
+                    continue;
+                ri.Add(rj);
+                g.DamageRects[i] = ImVec4(ri.Min.x, ri.Min.y, ri.Max.x, ri.Max.y);
+                g.DamageRects.erase(g.DamageRects.Data + j);
+                merged = true;
+            }
+    }
 }
 
 // When using this function it is sane to ensure that float are perfectly rounded to integer values, to that e.g. (int)(max.x-min.x) in user's render produce correct result.
@@ -3947,6 +4610,69 @@ void ImGui::PopClipRect()
     window->ClipRect = window->DrawList->_ClipRectStack.back();
 }
 
+// Decide whether the next frame can differ from this one without new inputs, see io.WantNextFrame
+// Called at the end of the frame, before input data are cleared.
+static void ImGui::UpdateWantNextFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    bool want_next_frame = (g.FrameCount < 3) || (g.RequestFrameDelay <= 0.0f) || (g.InputEventsQueue.Size > 0);
+
+    // Inputs received this frame, or held: the frame after an input also resolves all the one-frame lags (hovering, focus, layout of newly submitted contents)
+    if (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f || io.MouseWheel != 0.0f || io.MouseWheelH != 0.0f || io.InputCharacters[0] != 0 || io.WantSetMousePos)
+        want_next_frame = true;
+    if (io.KeyCtrl || io.KeyShift || io.KeyAlt || io.KeySuper)
+        want_next_frame = true;
+    for (int i = 0; i < IM_ARRAYSIZE(io.MouseDown) && !want_next_frame; i++)
+        if (io.MouseDown[i] || io.MouseReleased[i])
+            want_next_frame = true;
+    for (int i = 0; i < IM_ARRAYSIZE(io.KeysDown) && !want_next_frame; i++)
+        if (io.KeysDown[i] || io.KeysDownDurationPrev[i] >= 0.0f)
+            want_next_frame = true;
+    for (int i = 0; i < IM_ARRAYSIZE(io.NavInputs) && !want_next_frame; i++)
+        if (io.NavInputs[i] > 0.0f || io.NavInputsDownDurationPrev[i] >= 0.0f)
+            want_next_frame = true;
+
+    // Interactions and requests completed on the next frame. An active text input only needs frames to blink its cursor (see InputTextEx).
+    if (g.ActiveId != 0 && g.ActiveId != g.InputTextState.Id)
+        want_next_frame = true;
+    if (g.ActiveIdIsJustActivated || g.DragDropActive || g.MovingWindow || g.NavWindowingTarget || g.NavNextActivateId != 0)
+        want_next_frame = true;
+    if (g.NavInitRequest || g.NavMoveRequest || g.NavMoveRequestForward != ImGuiNavForward_None || g.NavMousePosDirty)
+        want_next_frame = true;
+    if (GetFrontMostModalRootWindow() != NULL && g.ModalWindowDarkeningRatio < 1.0f)
+        want_next_frame = true;
+    for (int n = 0; n < g.OpenPopupStack.Size && !want_next_frame; n++)
+        if (g.OpenPopupStack[n].OpenFrameCount >= g.FrameCount - 1)
+            want_next_frame = true;
+    if (ImFontAtlasBuildDynamicHasFailedGlyphs(g.IO.Fonts))   // Rendered with the fallback glyph until the atlas texture grows
+        want_next_frame = true;
+
+    // Windows appearing, disappearing, auto-resizing or scrolling. Contents whose size changed affect auto-fit and scrollbars of the next frame.
+    for (int n = 0; n < g.Windows.Size && !want_next_frame; n++)
+    {
+        ImGuiWindow* window = g.Windows[n];
+        if (window->Active != window->WasActive || window->HiddenFrames > 0 || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0)
+            want_next_frame = true;
+        else if (window->Active && (window->ScrollTarget.x < FLT_MAX || window->ScrollTarget.y < FLT_MAX || window->FocusIdxAllRequestNext != INT_MAX || window->FocusIdxTabRequestNext != INT_MAX))
+            want_next_frame = true;
+        else if (window->Active && !window->Collapsed)
+        {
+            ImVec2 size_contents = CalcSizeContents(window);
+            if (size_contents.x != window->SizeContents.x || size_contents.y != window->SizeContents.y)
+                want_next_frame = true;
+        }
+    }
+
+    // Timers
+    float timeout = g.RequestFrameDelay;
+    if (g.SettingsDirtyTimer > 0.0f && g.IO.IniFilename != NULL)
+        timeout = ImMin(timeout, g.SettingsDirtyTimer);
+
+    io.WantNextFrame = want_next_frame;
+    io.NextFrameTimeout = want_next_frame ? 0.0f : timeout;
+}
+
 // This is normally called by Render(). You may want to call it directly if you want to avoid calling Render() but the gain will be very minimal.
 void ImGui::EndFrame()
 {
@@ -3967,6 +4693,7 @@ void ImGui::EndFrame()
     if (g.CurrentWindow && !g.CurrentWindow->WriteAccessed)
         g.CurrentWindow->Active = false;
     End();
+    ProfilerPushZone("EndFrame");
 
     if (g.ActiveId == 0 && g.HoveredId == 0)
     {
@@ -4030,12 +4757,15 @@ void ImGui::EndFrame()
     IM_ASSERT(g.Windows.Size == g.WindowsSortBuffer.Size);  // we done something wrong
     g.Windows.swap(g.WindowsSortBuffer);
 
+    UpdateWantNextFrame();
+
     // Clear Input data for next frame
     g.IO.MouseWheel = g.IO.MouseWheelH = 0.0f;
     memset(g.IO.InputCharacters, 0, sizeof(g.IO.InputCharacters));
     memset(g.IO.NavInputs, 0, sizeof(g.IO.NavInputs));
 
     g.FrameCountEnded = g.FrameCount;
+    ProfilerPopZone();
 }
 
 void ImGui::Render()
@@ -4046,8 +4776,10 @@ void ImGui::Render()
     if (g.FrameCountEnded != g.FrameCount)
         ImGui::EndFrame();
     g.FrameCountRendered = g.FrameCount;
+    ProfilerPushZone("Render");
 
     // Gather windows to render
+    ProfilerPushZone("AddDrawListToDrawData");
     g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsActiveWindows = 0;
     g.DrawDataBuilder.Clear();
     ImGuiWindow* window_to_render_front_most = (g.NavWindowingTarget && !(g.NavWindowingTarget->Flags & ImGuiWindowFlags_NoBringToFrontOnFocus)) ? g.NavWindowingTarget : NULL;
@@ -4060,6 +4792,7 @@ void ImGui::Render()
     if (window_to_render_front_most && window_to_render_front_most->Active && window_to_render_front_most->HiddenFrames <= 0) // NavWindowingTarget is always temporarily displayed as the front-most window
         AddWindowToDrawDataSelectLayer(window_to_render_front_most);
     g.DrawDataBuilder.FlattenIntoSingleLayer();
+    ProfilerPopZone();
 
     // Draw software mouse cursor if requested
     ImVec2 offset, size, uv[4];
@@ -4077,6 +4810,9 @@ void ImGui::Render()
     }
     if (!g.OverlayDrawList.VtxBuffer.empty())
         AddDrawListToDrawData(&g.DrawDataBuilder.Layers[0], &g.OverlayDrawList);
+    UpdateDamageRects(&g.DrawDataBuilder.Layers[0]);
+    if (g.IO.OptMergeDrawLists)
+        MergeDrawLists(&g.DrawDataBuilder.Layers[0]);
 
     // Setup ImDrawData structure for end-user
     SetupDrawData(&g.DrawDataBuilder.Layers[0], &g.DrawData);
@@ -4088,6 +4824,9 @@ void ImGui::Render()
     if (g.DrawData.CmdListsCount > 0 && g.IO.RenderDrawListsFn != NULL)
         g.IO.RenderDrawListsFn(&g.DrawData);
 #endif
+    ProfilerPopZone();
+    if (g.ProfilerFrameActive)
+        ProfilerEndFrame();
 }
 
 const char* ImGui::FindRenderedTextEnd(const char* text, const char* text_end)
@@ -5510,6 +6249,8 @@ static void ImGui::UpdateManualResize(ImGuiWindow* window, const ImVec2& size_au
         bool hovered, held;
         ImRect border_rect = GetBorderRect(window, border_n, grip_hover_size, BORDER_SIZE);
         ButtonBehavior(border_rect, window->GetID((void*)(intptr_t)(border_n + 4)), &hovered, &held, ImGuiButtonFlags_FlattenChildren);
+        if (hovered && g.HoveredIdTimer <= BORDER_APPEAR_TIMER)
+            RequestFrame(BORDER_APPEAR_TIMER - g.HoveredIdTimer + 0.001f);
         if ((hovered && g.HoveredIdTimer > BORDER_APPEAR_TIMER) || held)
         {
             g.MouseCursor = (border_n & 1) ? ImGuiMouseCursor_ResizeEW : ImGuiMouseCursor_ResizeNS;
@@ -5577,6 +6318,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     IM_ASSERT(name != NULL);                        // Window name required
     IM_ASSERT(g.Initialized);                       // Forgot to call ImGui::NewFrame()
     IM_ASSERT(g.FrameCountEnded != g.FrameCount);   // Called ImGui::Render() or ImGui::EndFrame() and haven't called ImGui::NewFrame() again yet
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Window);
 
     // Find or create
     ImGuiWindow* window = FindWindowByName(name);
@@ -5585,6 +6327,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         ImVec2 size_on_first_use = (g.NextWindowData.SizeCond != 0) ? g.NextWindowData.SizeVal : ImVec2(0.0f, 0.0f); // Any condition flag will do since we are creating a new window here.
         window = CreateNewWindow(name, size_on_first_use, flags);
     }
+    ProfilerPushZone(window->Name); // Popped by End()
 
     // Automatically disable manual moving/resizing when NoInputs is set
     if (flags & ImGuiWindowFlags_NoInputs)
@@ -6205,6 +6948,7 @@ void ImGui::End()
 {
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_Window);
 
     if (window->DC.ColumnsSet != NULL)
         EndColumns();
@@ -6220,6 +6964,7 @@ void ImGui::End()
         g.CurrentPopupStack.pop_back();
     CheckStacksSize(window, false);
     SetCurrentWindow(g.CurrentWindowStack.empty() ? NULL : g.CurrentWindowStack.back());
+    ProfilerPopZone();
 }
 
 // Vertical scrollbar
@@ -9865,6 +10610,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
         return false;
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_TextEdit);
 
     IM_ASSERT(!((flags & ImGuiInputTextFlags_CallbackHistory) && (flags & ImGuiInputTextFlags_Multiline))); // Can't use both together (they both use up/down keys)
     IM_ASSERT(!((flags & ImGuiInputTextFlags_CallbackCompletion) && (flags & ImGuiInputTextFlags_AllowTabInput))); // Can't use both together (they both use tab key)
@@ -9922,7 +10668,7 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
         password_font->ContainerAtlas = g.Font->ContainerAtlas;
         password_font->FallbackGlyph = glyph;
         password_font->FallbackAdvanceX = glyph->AdvanceX;
-        IM_ASSERT(password_font->Glyphs.empty() && password_font->IndexAdvanceX.empty() && password_font->IndexLookup.empty());
+        IM_ASSERT(password_font->Glyphs.empty() && password_font->ConfigDataCount == 0);   // Every lookup returns the fallback glyph
         PushFont(password_font);
     }
 
@@ -10414,6 +11160,12 @@ bool ImGui::InputTextEx(const char* label, char* buf, int buf_size, const ImVec2
 
         // Draw blinking cursor
         bool cursor_is_visible = (!g.IO.OptCursorBlink) || (g.InputTextState.CursorAnim <= 0.0f) || fmodf(g.InputTextState.CursorAnim, 1.20f) <= 0.80f;
+        if (g.IO.OptCursorBlink)
+        {
+            // Request a frame when the cursor toggles
+            float cursor_anim_phase = (g.InputTextState.CursorAnim <= 0.0f) ? g.InputTextState.CursorAnim : fmodf(g.InputTextState.CursorAnim, 1.20f);
+            RequestFrame((cursor_anim_phase <= 0.80f ? 0.80f : 1.20f) - cursor_anim_phase);
+        }
         ImVec2 cursor_screen_pos = render_pos + cursor_offset - render_scroll;
         ImRect cursor_screen_rect(cursor_screen_pos.x, cursor_screen_pos.y-g.FontSize+0.5f, cursor_screen_pos.x+1.0f, cursor_screen_pos.y-1.5f);
         if (cursor_is_visible && cursor_screen_rect.Overlaps(clip_rect))
@@ -13042,7 +13794,7 @@ void ImGui::EndDragDropTarget()
 // PLATFORM DEPENDENT HELPERS
 //-----------------------------------------------------------------------------
 
-#if defined(_WIN32) && !defined(_WINDOWS_) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS))
+#if defined(_WIN32) && !defined(_WINDOWS_) && (!defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS) || !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS) || !defined(IMGUI_DISABLE_PROFILER))
 #undef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
 #ifndef __MINGW32__
@@ -13052,6 +13804,39 @@ void ImGui::EndDragDropTarget()
 #endif
 #endif
 
+// Monotonic timer for the profiler, in seconds
+#if defined(IMGUI_DISABLE_PROFILER)
+
+static double ProfilerGetTime()
+{
+    return 0.0;
+}
+
+#elif defined(_WIN32)
+
+static double ProfilerGetTime()
+{
+    static IM_THREAD_LOCAL LARGE_INTEGER frequency = { 0 };
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+}
+
+#else
+
+#include <time.h>   // clock_gettime
+
+static double ProfilerGetTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+#endif
+
 // Win32 API clipboard implementation
 #if defined(_WIN32) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_CLIPBOARD_FUNCTIONS)
 
@@ -13061,7 +13846,7 @@ void ImGui::EndDragDropTarget()
 
 static const char* GetClipboardTextFn_DefaultImpl(void*)
 {
-    static ImVector<char> buf_local;
+    static IM_THREAD_LOCAL ImVector<char> buf_local;
     buf_local.clear();
     if (!OpenClipboard(NULL))
         return NULL;
@@ -13163,7 +13948,99 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         ImGui::Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
         ImGui::Text("%d vertices, %d indices (%d triangles)", ImGui::GetIO().MetricsRenderVertices, ImGui::GetIO().MetricsRenderIndices, ImGui::GetIO().MetricsRenderIndices / 3);
         ImGui::Text("%d allocations", (int)GImAllocatorActiveAllocationsCount);
-        static bool show_clip_rects = true;
+        if (ImGui::GetIO().WantNextFrame)
+            ImGui::Text("Next frame: needed (previous frame)");
+        else if (ImGui::GetIO().NextFrameTimeout < FLT_MAX)
+            ImGui::Text("Next frame: idle, needed in %.3f sec (previous frame)", ImGui::GetIO().NextFrameTimeout);
+        else
+            ImGui::Text("Next frame: idle until inputs (previous frame)");
+        if (ImGui::GetIO().OptDamageRects)
+        {
+            const ImVector<ImVec4>& damage_rects = GImGui->DamageRects;
+            float damage_area = 0.0f;
+            for (int n = 0; n < damage_rects.Size; n++)
+                damage_area += (damage_rects[n].z - damage_rects[n].x) * (damage_rects[n].w - damage_rects[n].y);
+            const float display_area = ImGui::GetIO().DisplaySize.x * ImGui::GetIO().DisplaySize.y;
+            ImGui::Text("%d damage rectangles (%.1f%% of display)", damage_rects.Size, display_area > 0.0f ? damage_area * 100.0f / display_area : 0.0f);
+        }
+        const ImGuiMemStats& mem_stats = ImGui::GetMemStats();
+        if (ImGui::TreeNode("Memory", "Memory: %d KB live, %d allocations last frame", (int)(mem_stats.BytesLive / 1024), mem_stats.AllocCount))
+        {
+            static const char* owner_names[ImGuiMemOwner_COUNT] = { "Other", "DrawList", "Storage", "TextEdit", "FontAtlas", "Window" };
+            ImGui::BulletText("Last frame: %d allocs (%d bytes), %d frees (%d bytes)", mem_stats.AllocCount, (int)mem_stats.BytesAllocated, mem_stats.FreeCount, (int)mem_stats.BytesFreed);
+            ImGui::BulletText("Live: %d bytes, peak during frame: %d bytes", (int)mem_stats.BytesLive, (int)mem_stats.BytesPeak);
+            for (int owner = 0; owner < ImGuiMemOwner_COUNT; owner++)
+                ImGui::BulletText("%-10s %8d bytes live, %d allocs last frame", owner_names[owner], (int)mem_stats.BytesLiveByOwner[owner], mem_stats.AllocCountByOwner[owner]);
+            ImGui::TreePop();
+        }
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        if (atlas->TexWidth > 0 && atlas->TexHeight > 0)
+        {
+            // Occupancy: glyphs surface (approximated by ImFont::MetricsTotalSurface) and custom rectangles, over the texture surface
+            const int tex_surface = atlas->TexWidth * atlas->TexHeight;
+            const int tex_bytes = (atlas->TexPixelsAlpha8 ? tex_surface : 0) + (atlas->TexPixelsRGBA32 ? tex_surface * 4 : 0);
+            int custom_rects_surface = 0;
+            for (int n = 0; n < atlas->CustomRects.Size; n++)
+                if (atlas->CustomRects[n].Font == NULL && atlas->CustomRects[n].IsPacked())
+                    custom_rects_surface += atlas->CustomRects[n].Width * atlas->CustomRects[n].Height;
+            int used_surface = custom_rects_surface;
+            for (int n = 0; n < atlas->Fonts.Size; n++)
+                used_surface += atlas->Fonts[n]->MetricsTotalSurface;
+            if (ImGui::TreeNode("Font atlas", "Font atlas: %dx%d, %d KB, %.1f%% occupied", atlas->TexWidth, atlas->TexHeight, tex_bytes / 1024, used_surface * 100.0f / tex_surface))
+            {
+                for (int n = 0; n < atlas->Fonts.Size; n++)
+                {
+                    ImFont* font = atlas->Fonts[n];
+                    ImGui::BulletText("%s: %d glyphs, %d pixels (%.1f%%)", font->GetDebugName(), font->Glyphs.Size, font->MetricsTotalSurface, font->MetricsTotalSurface * 100.0f / tex_surface);
+                }
+                ImGui::BulletText("Custom rectangles: %d pixels (%.1f%%)", custom_rects_surface, custom_rects_surface * 100.0f / tex_surface);
+                ImGui::TreePop();
+            }
+        }
+        if (ImGui::TreeNode("Profiler"))
+        {
+            ImGuiIO& io = ImGui::GetIO();
+            ImGui::Checkbox("Record (io.OptProfiler)", &io.OptProfiler);
+            const int frames_count = ImGui::GetProfilerFramesCount();
+            static IM_THREAD_LOCAL int frame_offset = 0;
+            frame_offset = ImClamp(frame_offset, 0, ImMax(frames_count - 1, 0));
+            if (frames_count > 0)
+            {
+                struct FuncsProfiler { static float GetFrameDuration(void* data, int idx) { return ImGui::GetProfilerFrame(*(int*)data - 1 - idx)->DurationMs; } };
+                ImGui::PlotHistogram("##Frames", FuncsProfiler::GetFrameDuration, (void*)&frames_count, frames_count, 0, "Frame durations (ms)", 0.0f, FLT_MAX, ImVec2(0, 50));
+                ImGui::SliderInt("Frames ago", &frame_offset, 0, frames_count - 1);
+                const ImGuiProfilerFrame* frame = ImGui::GetProfilerFrame(frame_offset);
+                ImGui::Text("Frame %d: %.3f ms, %d zones", frame->FrameCount, frame->DurationMs, frame->Zones.Size);
+
+                // Flame graph: one row per nesting level, zones scaled to the duration of the frame
+                int max_depth = 0;
+                for (int n = 0; n < frame->Zones.Size; n++)
+                    max_depth = ImMax(max_depth, frame->Zones[n].Depth);
+                const float row_height = ImGui::GetTextLineHeight() + 2.0f;
+                const ImVec2 graph_size(ImMax(ImGui::GetContentRegionAvailWidth(), 100.0f), row_height * (max_depth + 1));
+                const ImVec2 graph_pos = ImGui::GetCursorScreenPos();
+                ImGui::InvisibleButton("##FlameGraph", graph_size);
+                const bool graph_hovered = ImGui::IsItemHovered();
+                ImDrawList* draw_list = ImGui::GetWindowDrawList();
+                draw_list->AddRectFilled(graph_pos, graph_pos + graph_size, ImGui::GetColorU32(ImGuiCol_FrameBg));
+                const float ms_to_px = (frame->DurationMs > 0.0f) ? graph_size.x / frame->DurationMs : 0.0f;
+                for (int n = 0; n < frame->Zones.Size; n++)
+                {
+                    const ImGuiProfilerZone& zone = frame->Zones[n];
+                    ImRect zone_bb(graph_pos.x + zone.StartMs * ms_to_px, graph_pos.y + zone.Depth * row_height, graph_pos.x + zone.EndMs * ms_to_px, graph_pos.y + (zone.Depth + 1) * row_height - 1.0f);
+                    zone_bb.Max.x = ImMax(zone_bb.Max.x, zone_bb.Min.x + 1.0f);
+                    const float hue = (ImHash(zone.Name, 0) & 0xFF) / 255.0f;
+                    const bool zone_hovered = graph_hovered && zone_bb.Contains(ImGui::GetIO().MousePos);
+                    draw_list->AddRectFilled(zone_bb.Min, zone_bb.Max, ImColor::HSV(hue, 0.5f, zone_hovered ? 0.9f : 0.7f));
+                    if (zone_bb.GetWidth() > 20.0f)
+                        ImGui::RenderTextClipped(zone_bb.Min + ImVec2(2.0f, 1.0f), zone_bb.Max, zone.Name, NULL, NULL, ImVec2(0.0f, 0.0f), &zone_bb);
+                    if (zone_hovered)
+                        ImGui::SetTooltip("%s\n%.3f ms (%.3f..%.3f)", zone.Name, zone.EndMs - zone.StartMs, zone.StartMs, zone.EndMs);
+                }
+            }
+            ImGui::TreePop();
+        }
+        static IM_THREAD_LOCAL bool show_clip_rects = true;
         ImGui::Checkbox("Show clipping rectangles when hovering draw commands", &show_clip_rects);
         ImGui::Separator();
 
@@ -13221,8 +14098,9 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                             for (int n = 0; n < 3; n++, vtx_i++)
                             {
                                 ImDrawVert& v = draw_list->VtxBuffer[idx_buffer ? idx_buffer[vtx_i] : vtx_i];
+                                const ImVec2 uv = v.uv;
                                 triangles_pos[n] = v.pos;
-                                buf_p += ImFormatString(buf_p, (int)(buf_end - buf_p), "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n", (n == 0) ? "vtx" : "   ", vtx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                                buf_p += ImFormatString(buf_p, (int)(buf_end - buf_p), "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n", (n == 0) ? "vtx" : "   ", vtx_i, triangles_pos[n].x, triangles_pos[n].y, uv.x, uv.y, v.col);
                             }
                             ImGui::Selectable(buf, false);
                             if (ImGui::IsItemHovered())
@@ -13283,6 +14161,11 @@ void ImGui::ShowMetricsWindow(bool* p_open)
                     ImGui::TreePop();
                 }
                 ImGui::BulletText("Storage: %d bytes", window->StateStorage.Data.Size * (int)sizeof(ImGuiStorage::Pair));
+                ImDrawList* draw_list = window->DrawList;
+                int draw_list_bytes = draw_list->VtxBuffer.Capacity * (int)sizeof(ImDrawVert) + draw_list->IdxBuffer.Capacity * (int)sizeof(ImDrawIdx) + draw_list->CmdBuffer.Capacity * (int)sizeof(ImDrawCmd) + draw_list->_Path.Capacity * (int)sizeof(ImVec2);
+                for (int channel_n = 0; channel_n < draw_list->_Channels.Size; channel_n++)
+                    draw_list_bytes += draw_list->_Channels[channel_n].CmdBuffer.Capacity * (int)sizeof(ImDrawCmd) + draw_list->_Channels[channel_n].IdxBuffer.Capacity * (int)sizeof(ImDrawIdx);
+                ImGui::BulletText("DrawList buffers: %d bytes reserved (%d/%d vtx, %d/%d idx)", draw_list_bytes, draw_list->VtxBuffer.Size, draw_list->VtxBuffer.Capacity, draw_list->IdxBuffer.Size, draw_list->IdxBuffer.Capacity);
                 ImGui::TreePop();
             }
         };
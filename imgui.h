@@ -56,9 +56,11 @@ struct ImDrawCmd;                   // A single draw command within a parent ImD
 struct ImDrawData;                  // All draw command lists required to render the frame
 struct ImDrawList;                  // A single draw command list (generally one per window)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
-struct ImDrawVert;                  // A single vertex (20 bytes by default, override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+struct ImDrawListShapeCache;        // Tessellated rounded rectangles kept by a draw list from one frame to the next (see AddRect(), AddRectFilled())
+struct ImDrawVert;                  // A single vertex (20 bytes by default, 16 or 12 bytes with IMGUI_USE_COMPACT_DRAWVERT, override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasDynamicData;      // State kept by the font atlas to rasterize glyphs on first use (ImFontAtlasFlags_DynamicGlyphs)
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
@@ -70,6 +72,9 @@ struct ImGuiTextBuffer;             // Text buffer for logging/accumulating text
 struct ImGuiTextEditCallbackData;   // Shared state of ImGui::InputText() when using custom ImGuiTextEditCallback (rare/advanced use)
 struct ImGuiSizeCallbackData;       // Structure used to constraint window size in custom ways when using custom ImGuiSizeCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiMemStats;               // Allocation statistics of a frame, see GetMemStats()
+struct ImGuiProfilerFrame;          // CPU timings of a frame, see GetProfilerFrame()
+struct ImGuiProfilerZone;           // A timed section of a frame (NewFrame(), a window, Render(), etc.)
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiContext;                // ImGui context (opaque)
 
@@ -85,11 +90,13 @@ typedef int ImGuiCol;               // enum: a color identifier for styling
 typedef int ImGuiDir;               // enum: a cardinal direction               // enum ImGuiDir_
 typedef int ImGuiCond;              // enum: a condition for Set*()             // enum ImGuiCond_
 typedef int ImGuiKey;               // enum: a key identifier (ImGui-side enum) // enum ImGuiKey_
+typedef int ImGuiMemOwner;          // enum: a category of memory allocations   // enum ImGuiMemOwner_
 typedef int ImGuiNavInput;          // enum: an input identifier for navigation // enum ImGuiNavInput_
 typedef int ImGuiMouseCursor;       // enum: a mouse cursor identifier          // enum ImGuiMouseCursor_
 typedef int ImGuiStyleVar;          // enum: a variable identifier for styling  // enum ImGuiStyleVar_
 typedef int ImDrawCornerFlags;      // flags: for ImDrawList::AddRect*() etc.   // enum ImDrawCornerFlags_
 typedef int ImDrawListFlags;        // flags: for ImDrawList                    // enum ImDrawListFlags_
+typedef int ImDrawVertFormat;       // enum: layout of ImDrawVert               // enum ImDrawVertFormat_
 typedef int ImFontAtlasFlags;       // flags: for ImFontAtlas                   // enum ImFontAtlasFlags_
 typedef int ImGuiBackendFlags;      // flags: for io.BackendFlags               // enum ImGuiBackendFlags_
 typedef int ImGuiColorEditFlags;    // flags: for ColorEdit*(), ColorPicker*()  // enum ImGuiColorEditFlags_
@@ -155,6 +162,8 @@ namespace ImGui
     // Demo, Debug, Information
     IMGUI_API void          ShowDemoWindow(bool* p_open = NULL);        // create demo/test window (previously called ShowTestWindow). demonstrate most ImGui features. call this to learn about the library! try to make it always available in your application!
     IMGUI_API void          ShowMetricsWindow(bool* p_open = NULL);     // create metrics window. display ImGui internals: draw commands (with individual draw calls and vertices), window list, basic internal state, etc.
+    IMGUI_API int           GetProfilerFramesCount();                   // number of frames recorded by the profiler (enable with io.OptProfiler).
+    IMGUI_API const ImGuiProfilerFrame* GetProfilerFrame(int n = 0);    // CPU timings recorded by the profiler. n = 0: last complete frame, n = 1: the frame before, etc. NULL if not available.
     IMGUI_API void          ShowStyleEditor(ImGuiStyle* ref = NULL);    // add style editor block (not a window). you can pass in a reference ImGuiStyle structure to compare to, revert to and save to (else it uses the default style)
     IMGUI_API bool          ShowStyleSelector(const char* label);       // add style selector block (not a window), essentially a combo listing the default styles.
     IMGUI_API void          ShowFontSelector(const char* label);        // add font selector block (not a window), essentially a combo listing the loaded fonts.
@@ -498,6 +507,7 @@ namespace ImGui
     IMGUI_API bool          IsRectVisible(const ImVec2& rect_min, const ImVec2& rect_max);      // test if rectangle (in screen space) is visible / not clipped. to perform coarse clipping on user's side.
     IMGUI_API float         GetTime();
     IMGUI_API int           GetFrameCount();
+    IMGUI_API void          RequestFrame(float delay = 0.0f);                                   // request a new frame within 'delay' seconds even without user inputs, for your own animations. reported by io.WantNextFrame/io.NextFrameTimeout.
     IMGUI_API ImDrawList*   GetOverlayDrawList();                                               // this draw list will be the last rendered one, useful to quickly draw overlays shapes/text
     IMGUI_API ImDrawListSharedData* GetDrawListSharedData();                                    // you may use this when creating your own ImDrawList instances
     IMGUI_API const char*   GetStyleColorName(ImGuiCol idx);
@@ -544,9 +554,12 @@ namespace ImGui
     // Memory Utilities
     // All those functions are not reliant on the current context.
     // If you reload the contents of imgui.cpp at runtime, you may need to call SetCurrentContext() + SetAllocatorFunctions() again.
-    IMGUI_API void          SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void(*free_func)(void* ptr, void* user_data), void* user_data = NULL);
+    // The optional realloc_func is used by ImVector<> growth: return 'ptr' to grow in place (preserving the first old_size bytes), or a new block. Default is MemAlloc() + memcpy() + MemFree().
+    IMGUI_API void          SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void(*free_func)(void* ptr, void* user_data), void* user_data = NULL, void* (*realloc_func)(void* ptr, size_t old_size, size_t new_size, void* user_data) = NULL);
     IMGUI_API void*         MemAlloc(size_t size);
     IMGUI_API void          MemFree(void* ptr);
+    IMGUI_API void*         MemRealloc(void* ptr, size_t old_size, size_t new_size);    // old_size: number of bytes to preserve. ptr may be NULL.
+    IMGUI_API const ImGuiMemStats& GetMemStats();                                       // allocation statistics of the last complete frame (between the last two calls to NewFrame() of any context). Also see ShowMetricsWindow().
 
 } // namespace ImGui
 
@@ -936,6 +949,18 @@ enum ImGuiMouseCursor_
 #endif
 };
 
+// Categories of memory allocations, for ImGuiMemStats
+enum ImGuiMemOwner_
+{
+    ImGuiMemOwner_Other = 0,            // Anything not listed below, including user calls to MemAlloc()
+    ImGuiMemOwner_DrawList,             // ImDrawList buffers
+    ImGuiMemOwner_Storage,              // ImGuiStorage (window state storage, tree nodes open state, etc.)
+    ImGuiMemOwner_TextEdit,             // InputText() internal buffers
+    ImGuiMemOwner_FontAtlas,            // ImFontAtlas, fonts and texture data
+    ImGuiMemOwner_Window,               // Windows and their internal data, excluding the above
+    ImGuiMemOwner_COUNT
+};
+
 // Condition for ImGui::SetWindow***(), SetNextWindow***(), SetNextTreeNode***() functions
 // All those functions treat 0 as a shortcut to ImGuiCond_Always. From the point of view of the user use this as an enum (don't combine multiple values into flags).
 enum ImGuiCond_
@@ -1024,6 +1049,10 @@ struct ImGuiIO
     // Advanced/subtle behaviors
     bool          OptMacOSXBehaviors;       // = defined(__APPLE__) // OS X style: Text editing cursor movement using Alt instead of Ctrl, Shortcuts using Cmd/Super instead of Ctrl, Line/Text Start and End using Cmd+Arrows instead of Home/End, Double click selects by word instead of selecting whole text, Multi-selection in lists uses Cmd/Super instead of Ctrl
     bool          OptCursorBlink;           // = true               // Enable blinking cursor, for users who consider it annoying.
+    bool          OptMergeDrawLists;        // = false              // Render() copies consecutive draw lists into merged vertex/index buffers, joining draw commands which share a texture and compatible clip rectangles. Trades some CPU copying for fewer draw calls.
+    bool          OptDamageRects;           // = false              // Render() compares the contents, bounds and order of every draw list with the previous frame to fill ImDrawData::DamageRects, so your renderer can redraw only the regions which changed (e.g. software rendering, remote display). Costs a hash of all vertex/index buffers every frame.
+    bool          OptProfiler;              // = false              // Record the CPU time spent in NewFrame(), Render(), each window (from Begin() to End()) and font atlas building, for the last frames. See GetProfilerFrame() and ShowMetricsWindow().
+    bool          OptInputTrickle;          // = true               // When using the input event queue (AddMouseButtonEvent() etc.), NewFrame() spreads a press and a release of the same button or key received between two frames over several frames, so fast inputs are never lost at low frame rates. When false, all queued events are applied at once.
 
     //------------------------------------------------------------------
     // Settings (User Functions)
@@ -1068,6 +1097,16 @@ struct ImGuiIO
     IMGUI_API void AddInputCharactersUTF8(const char* utf8_chars);      // Add new characters into InputCharacters[] from an UTF-8 string
     inline void    ClearInputCharacters() { InputCharacters[0] = 0; }   // Clear the text input buffer manually
 
+    // Input event queue (optional, alternative to writing MousePos, MouseDown[], MouseWheel, KeysDown[], KeyCtrl etc. every frame)
+    // Submit events as they arrive from the OS. NewFrame() applies them in order, see OptInputTrickle. The back-end may write the fields directly for some inputs and use events for others.
+    // 'time' is the timestamp of the event in seconds, from any monotonic clock shared by all events (< 0.0: unknown). It is used to detect double-clicks accurately when they are spread over several frames.
+    IMGUI_API void AddMousePosEvent(float x, float y, double time = -1.0);
+    IMGUI_API void AddMouseButtonEvent(int button, bool down, double time = -1.0);      // button: index into MouseDown[]
+    IMGUI_API void AddMouseWheelEvent(float wheel_x, float wheel_y, double time = -1.0);
+    IMGUI_API void AddKeyEvent(int key_index, bool down, double time = -1.0);           // key_index: index into KeysDown[]
+    IMGUI_API void AddKeyModsEvent(bool ctrl, bool shift, bool alt, bool super, double time = -1.0);
+    IMGUI_API void ClearInputEvents();                                                  // Drop events not applied yet (e.g. when the application loses focus)
+
     //------------------------------------------------------------------
     // Output - Retrieve after calling NewFrame()
     //------------------------------------------------------------------
@@ -1083,6 +1122,8 @@ struct ImGuiIO
     int         MetricsRenderIndices;       // Indices output during last call to Render() = number of triangles * 3
     int         MetricsActiveWindows;       // Number of visible root windows (exclude child windows)
     ImVec2      MouseDelta;                 // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
+    bool        WantNextFrame;              // Set by EndFrame()/Render(). When false, the next frame will render the same as this one unless new inputs arrive: you may block on your OS events for up to NextFrameTimeout seconds instead of polling.
+    float       NextFrameTimeout;           // Set by EndFrame()/Render(). Delay in seconds after which a frame is needed even without inputs (e.g. blinking cursor, RequestFrame()). 0.0f when WantNextFrame is true, FLT_MAX when nothing is scheduled.
 
     //------------------------------------------------------------------
     // [Internal] ImGui will maintain those fields. Forward compatibility not guaranteed!
@@ -1186,11 +1227,7 @@ public:
     {
         if (new_capacity <= Capacity) 
             return;
-        value_type* new_data = (value_type*)ImGui::MemAlloc((size_t)new_capacity * sizeof(value_type));
-        if (Data)
-            memcpy(new_data, Data, (size_t)Size * sizeof(value_type));
-        ImGui::MemFree(Data);
-        Data = new_data;
+        Data = (value_type*)ImGui::MemRealloc(Data, (size_t)Size * sizeof(value_type), (size_t)new_capacity * sizeof(value_type));
         Capacity = new_capacity;
     }
 
@@ -1455,6 +1492,43 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
 };
 
+// Allocation statistics, see GetMemStats().
+// Every block allocated with MemAlloc() is tagged with the owner that was current when it was allocated. Reallocations keep the owner of the original block.
+// Counters are accumulated from one NewFrame() to the next. In a steady state, an application is expected to see AllocCount == 0.
+struct ImGuiMemStats
+{
+    int         AllocCount;                             // Number of blocks allocated during the frame (MemAlloc() and MemRealloc() calls)
+    int         FreeCount;                              // Number of blocks freed during the frame
+    size_t      BytesAllocated;                         // Bytes allocated during the frame
+    size_t      BytesFreed;                             // Bytes freed during the frame
+    size_t      BytesLive;                              // Bytes currently allocated, at the end of the frame
+    size_t      BytesPeak;                              // Maximum value of BytesLive during the frame
+    int         AllocCountByOwner[ImGuiMemOwner_COUNT]; // AllocCount for each ImGuiMemOwner_
+    size_t      BytesLiveByOwner[ImGuiMemOwner_COUNT];  // BytesLive for each ImGuiMemOwner_
+
+    ImGuiMemStats() { memset(this, 0, sizeof(*this)); }
+};
+
+// Profiler: a timed section of a frame, see GetProfilerFrame().
+// Zones are nested: window zones include the time spent in user code between Begin() and End(), and the zones of their child windows.
+struct ImGuiProfilerZone
+{
+    const char* Name;                   // "NewFrame", "Render", window name, etc. Valid until the frame is overwritten or the context destroyed.
+    int         Depth;                  // Nesting level (0 for top-level zones)
+    float       StartMs;                // Time relative to the start of the frame, in milliseconds
+    float       EndMs;
+};
+
+// Profiler: CPU timings of a frame, from NewFrame() to the end of Render(). Zones recorded outside of a frame (e.g. font atlas building) are added to the next frame.
+struct ImGuiProfilerFrame
+{
+    int         FrameCount;             // Value of ImGui::GetFrameCount() during the frame
+    float       DurationMs;             // Total duration of the frame
+    ImVector<ImGuiProfilerZone> Zones;  // Sorted by start time, parents before children
+
+    ImGuiProfilerFrame() { FrameCount = 0; DurationMs = 0.0f; }
+};
+
 //-----------------------------------------------------------------------------
 // Draw List
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
@@ -1483,13 +1557,73 @@ struct ImDrawCmd
 typedef unsigned short ImDrawIdx;
 #endif
 
-// Vertex layout
+// Vertex layout (see ImDrawData::VtxFormat)
+enum ImDrawVertFormat_
+{
+    ImDrawVertFormat_Default,               // ImVec2 pos, ImVec2 uv, ImU32 col (20 bytes), or your own layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+    ImDrawVertFormat_CompactUV,             // ImVec2 pos, 2 x unsigned short normalized uv, ImU32 col (16 bytes), with IMGUI_USE_COMPACT_DRAWVERT
+    ImDrawVertFormat_CompactUVHalfPos       // 2 x half-float pos, 2 x unsigned short normalized uv, ImU32 col (12 bytes), with IMGUI_USE_DRAWVERT_HALF_POS
+};
+
+#if defined(IMGUI_USE_DRAWVERT_HALF_POS) && !defined(IMGUI_USE_COMPACT_DRAWVERT)
+#define IMGUI_USE_COMPACT_DRAWVERT
+#endif
+
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// 2D vector stored as two 16-bit unsigned normalized values (0 = 0.0f, 65535 = 1.0f), converts from/to ImVec2.
+struct ImVec2UNorm16
+{
+    unsigned short x, y;
+    ImVec2UNorm16() {}
+    ImVec2UNorm16(const ImVec2& v)                  { *this = v; }
+    ImVec2UNorm16& operator=(const ImVec2& v)       { x = (unsigned short)((v.x <= 0.0f ? 0.0f : v.x >= 1.0f ? 1.0f : v.x) * 65535.0f + 0.5f); y = (unsigned short)((v.y <= 0.0f ? 0.0f : v.y >= 1.0f ? 1.0f : v.y) * 65535.0f + 0.5f); return *this; }
+    operator ImVec2() const                         { return ImVec2(x * (1.0f / 65535.0f), y * (1.0f / 65535.0f)); }
+};
+
+// 2D vector stored as two IEEE 754 half-floats, converts from/to ImVec2. Tiny values are flushed to zero, large values are clamped to +/-65504.
+struct ImVec2Half
+{
+    unsigned short x, y;
+    ImVec2Half() {}
+    ImVec2Half(const ImVec2& v)                     { *this = v; }
+    ImVec2Half& operator=(const ImVec2& v)          { x = FloatToHalf(v.x); y = FloatToHalf(v.y); return *this; }
+    operator ImVec2() const                         { return ImVec2(HalfToFloat(x), HalfToFloat(y)); }
+
+    static inline unsigned short FloatToHalf(float f)
+    {
+        union { float f; unsigned int u; } v; v.f = f;
+        const unsigned int sign = (v.u >> 16) & 0x8000;
+        const int exponent = (int)((v.u >> 23) & 0xFF) - 127 + 15;
+        if (exponent <= 0)
+            return (unsigned short)sign;
+        unsigned int h = ((unsigned int)exponent << 10) | ((v.u & 0x7FFFFF) >> 13);
+        h += (v.u >> 12) & 1;                       // Round to nearest
+        return (unsigned short)(sign | (h >= 0x7C00 ? 0x7BFF : h));
+    }
+    static inline float HalfToFloat(unsigned short h)
+    {
+        union { float f; unsigned int u; } v;
+        const unsigned int exponent = (h >> 10) & 0x1F;
+        v.u = ((unsigned int)(h & 0x8000) << 16) | (exponent ? (((exponent - 15 + 127) << 23) | ((unsigned int)(h & 0x3FF) << 13)) : 0);
+        return v.f;
+    }
+};
+#endif
+
 #ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
 struct ImDrawVert
 {
-    ImVec2  pos;
-    ImVec2  uv;
-    ImU32   col;
+#if defined(IMGUI_USE_DRAWVERT_HALF_POS)
+    ImVec2Half      pos;
+    ImVec2UNorm16   uv;
+#elif defined(IMGUI_USE_COMPACT_DRAWVERT)
+    ImVec2          pos;
+    ImVec2UNorm16   uv;
+#else
+    ImVec2          pos;
+    ImVec2          uv;
+#endif
+    ImU32           col;
 };
 #else
 // You can override the vertex format layout by defining IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT in imconfig.h
@@ -1552,9 +1686,10 @@ struct ImDrawList
     int                     _ChannelsCurrent;   // [Internal] current channel number (0)
     int                     _ChannelsCount;     // [Internal] number of active channels (1+)
     ImVector<ImDrawChannel> _Channels;          // [Internal] draw channels for columns API (not resized down so _ChannelsCount may be smaller than _Channels.Size)
+    ImDrawListShapeCache*   _ShapeCache;        // [Internal] tessellation cache of rounded rectangles, allocated on first use
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
-    ImDrawList(const ImDrawListSharedData* shared_data) { _Data = shared_data; _OwnerName = NULL; Clear(); }
+    ImDrawList(const ImDrawListSharedData* shared_data) { _Data = shared_data; _OwnerName = NULL; _ShapeCache = NULL; Clear(); }
     ~ImDrawList() { ClearFreeMemory(); }
     IMGUI_API void  PushClipRect(ImVec2 clip_rect_min, ImVec2 clip_rect_max, bool intersect_with_current_clip_rect = false);  // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
     IMGUI_API void  PushClipRectFullScreen();
@@ -1584,6 +1719,14 @@ struct ImDrawList
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, const int num_points, ImU32 col);
     IMGUI_API void  AddBezierCurve(const ImVec2& pos0, const ImVec2& cp0, const ImVec2& cp1, const ImVec2& pos1, ImU32 col, float thickness, int num_segments = 0);
 
+    // Batched primitives: submit 'count' primitives with a single PrimReserve(), output is the same as calling the matching Add***() function in a loop.
+    // Arrays are read with a byte stride so they can point inside your own structures. Pass a stride of 0 to use the same value for all primitives (e.g. a single color).
+    // Mind the 64K vertices limit per draw list when using 16-bit indices (~16K rectangles/points, ~10K anti-aliased lines).
+    IMGUI_API void  AddLineBatch(const ImVec2* a, const ImVec2* b, const ImU32* cols, int count, float thickness = 1.0f, int pos_stride = sizeof(ImVec2), int col_stride = sizeof(ImU32));
+    IMGUI_API void  AddRectFilledBatch(const ImVec2* a, const ImVec2* b, const ImU32* cols, int count, int pos_stride = sizeof(ImVec2), int col_stride = sizeof(ImU32));   // a: upper-left, b: lower-right, no rounding
+    IMGUI_API void  AddQuadFilledBatch(const ImVec2* points, const ImU32* cols, int count, int col_stride = sizeof(ImU32));                                              // 4 consecutive points per quad
+    IMGUI_API void  AddPointBatch(const ImVec2* centres, const ImU32* cols, int count, float size, int pos_stride = sizeof(ImVec2), int col_stride = sizeof(ImU32));     // size x size squares, e.g. markers for scatter plots
+
     // Stateful path API, add points then finish with PathFill() or PathStroke()
     inline    void  PathClear()                                                 { _Path.resize(0); }
     inline    void  PathLineTo(const ImVec2& pos)                               { _Path.push_back(pos); }
@@ -1631,11 +1774,21 @@ struct ImDrawData
     int             CmdListsCount;          // Number of ImDrawList* to render
     int             TotalIdxCount;          // For convenience, sum of all ImDrawList's IdxBuffer.Size
     int             TotalVtxCount;          // For convenience, sum of all ImDrawList's VtxBuffer.Size
+    ImDrawVertFormat VtxFormat;             // Layout of ImDrawVert, fixed at compile-time (see ImDrawVertFormat_). Render functions supporting compact layouts can use this to setup their vertex attributes.
+    ImVec4*         DamageRects;            // Non-overlapping regions of the display (x1,y1,x2,y2 in pixels) which may differ from the previous frame. Outside of them, rendering this frame gives the same output as the previous one. Single rectangle covering the display unless io.OptDamageRects is set.
+    int             DamageRectsCount;       // Number of rectangles in DamageRects[]. May be 0 when nothing changed.
 
     // Functions
     ImDrawData()    { Valid = false; Clear(); }
     ~ImDrawData()   { Clear(); }
-    void Clear()    { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; } // The ImDrawList are owned by ImGuiContext!
+    void Clear()    { Valid = false; CmdLists = NULL; CmdListsCount = TotalVtxCount = TotalIdxCount = 0; VtxFormat = GetVtxFormat(); DamageRects = NULL; DamageRectsCount = 0; } // The ImDrawList are owned by ImGuiContext!
+#if defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT) || !defined(IMGUI_USE_COMPACT_DRAWVERT)
+    static ImDrawVertFormat GetVtxFormat()  { return ImDrawVertFormat_Default; }
+#elif defined(IMGUI_USE_DRAWVERT_HALF_POS)
+    static ImDrawVertFormat GetVtxFormat()  { return ImDrawVertFormat_CompactUVHalfPos; }
+#else
+    static ImDrawVertFormat GetVtxFormat()  { return ImDrawVertFormat_CompactUV; }
+#endif
     IMGUI_API void  DeIndexAllBuffers();                // Helper to convert all buffers from indexed to non-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
     IMGUI_API void  ScaleClipRects(const ImVec2& sc);   // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
 };
@@ -1655,7 +1808,8 @@ struct ImFontConfig
     const ImWchar*  GlyphRanges;            // NULL     // Pointer to a user-provided list of Unicode range (2 value per range, values are inclusive, zero-terminated list). THE ARRAY DATA NEEDS TO PERSIST AS LONG AS THE FONT IS ALIVE.
     bool            MergeMode;              // false    // Merge into previous ImFont, so you can combine multiple inputs font into one ImFont (e.g. ASCII font + icons + Japanese glyphs). You may want to use GlyphOffset.y when merge font of different heights.
     unsigned int    RasterizerFlags;        // 0x00     // Settings for custom font rasterizer (e.g. ImGuiFreeType). Leave as zero if you aren't using one.
-    float           RasterizerMultiply;     // 1.0f     // Brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable.
+    float           RasterizerMultiply;     // 1.0f     // Brighten (>1.0f) or darken (<1.0f) font output. Brightening small fonts may be a good workaround to make them more readable. Ignored with ImFontAtlasFlags_SDF.
+    float           RasterizerScale;        // 1.0f     // Rasterize glyphs at SizePixels * RasterizerScale, while the font metrics stay at SizePixels. With ImFontAtlasFlags_SDF, a scale of 2 to 4 keeps text crisp when it is displayed much larger (io.FontGlobalScale, SetWindowFontScale(), zoomable canvas).
 
     // [Internal]
     char            Name[40];               // Name (strictly to ease debugging)
@@ -1672,10 +1826,21 @@ struct ImFontGlyph
     float           U0, V0, U1, V1;     // Texture coordinates
 };
 
+// Glyph lookup of a block of 256 code points, see ImFont::IndexPages[]
+struct ImFontIndexPage
+{
+    float           AdvanceX[256];      // Glyphs->AdvanceX, or a negative value for code points to look up with ImFont::LoadGlyphAdvanceX()
+    unsigned short  GlyphIndex[256];    // Index in ImFont::Glyphs, 0xFFFF for none
+};
+
 enum ImFontAtlasFlags_
 {
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
-    ImFontAtlasFlags_NoMouseCursors     = 1 << 1    // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 2,   // Build() only rasterizes Basic Latin + Latin Supplement, other glyphs of the GlyphRanges are rasterized on first use. Your back-end needs to upload TexUpdateRect before rendering, see below. Not supported by ImGuiFreeType.
+    ImFontAtlasFlags_SDF                = 1 << 3,   // Store signed distance fields instead of coverage for font glyphs: the texture is 128 on the glyph outlines, SDFSpread pixels away it is 0 outside and 255 inside. Your back-end needs to render the font texture with a distance field shader (see the OpenGL3 example).
+    ImFontAtlasFlags_IncrementalFonts   = 1 << 4,   // Fonts added after Build() are rasterized into the free space of the texture (growing it up to 16384x16384 if needed, else it is invalidated) and reported in TexUpdateRect. Implied by ImFontAtlasFlags_DynamicGlyphs. Not supported by ImGuiFreeType.
+    ImFontAtlasFlags_DiscardAlpha8      = 1 << 5    // GetTexDataAsRGBA32() frees the 1 byte per pixel texture once expanded, only the RGBA32 copy is kept. GetTexDataAsAlpha8() extracts it again. Not compatible with ImFontAtlasFlags_DynamicGlyphs and ImFontAtlasFlags_IncrementalFonts.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture.
@@ -1686,6 +1851,17 @@ enum ImFontAtlasFlags_
 //  3. Upload the pixels data into a texture within your graphics system.
 //  4. Call SetTexID(my_tex_id); and pass the pointer/identifier to your texture. This value will be passed back to you during rendering to identify the texture.
 // IMPORTANT: If you pass a 'glyph_ranges' array to AddFont*** functions, you need to make sure that your array persist up until the ImFont is build (when calling GetTextData*** or Build()). We only copy the pointer, not the data.
+// With ImFontAtlasFlags_DynamicGlyphs, glyphs are added to the texture while text is measured or rendered, so large ranges (e.g. GetGlyphRangesChinese()) don't cost anything until used:
+//  - Every frame after Render(), if TexUpdateRect is not empty, upload that region of the pixels (or the whole texture if TexWidth/TexHeight changed), then clear TexUpdateRect.
+//  - The glyph ranges arrays and the font data need to persist as long as the atlas. Don't call ClearInputData() or ClearTexData().
+//  - Glyphs that don't fit are rendered with the fallback glyph for one frame, then NewFrame() grows the texture.
+//  - The atlas is modified during the frame, so it cannot be shared by contexts running on different threads.
+// With ImFontAtlasFlags_IncrementalFonts, AddFont*() after the texture is built rasterizes only the new font, the other glyphs don't move:
+//  - Upload TexUpdateRect as above. Don't call ClearTexData(), which frees the packer: the next font added would rebuild the whole atlas.
+//  - Add fonts between frames. A MergeMode font can only be merged into the last font added.
+// With ImFontAtlasFlags_SDF, a single baked size stays sharp when scaled, instead of adding a font per size/DPI:
+//  - Set ImFontConfig::RasterizerScale to bake at a larger size (e.g. 2.0f), then draw with io.FontGlobalScale/SetWindowFontScale() or your own zoom.
+//  - In the fragment shader, for the font texture: alpha = clamp((d - 0.5) / fwidth(d) + 0.5, 0, 1) with d the texture alpha. Other pixels of the atlas (white pixel, mouse cursors) are 0 or 255 and render unchanged.
 struct ImFontAtlas
 {
     IMGUI_API ImFontAtlas();
@@ -1693,9 +1869,12 @@ struct ImFontAtlas
     IMGUI_API ImFont*           AddFont(const ImFontConfig* font_cfg);
     IMGUI_API ImFont*           AddFontDefault(const ImFontConfig* font_cfg = NULL);
     IMGUI_API ImFont*           AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);
-    IMGUI_API ImFont*           AddFontFromMemoryTTF(void* font_data, int font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // Note: Transfer ownership of 'ttf_data' to ImFontAtlas! Will be deleted after Build(). Set font_cfg->FontDataOwnedByAtlas to false to keep ownership.
+    IMGUI_API ImFont*           AddFontFromMemoryTTF(void* font_data, int font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // Note: Transfer ownership of 'ttf_data' to ImFontAtlas! Will be deleted after Build(), so allocate it with ImGui::MemAlloc() (not malloc()/new). Set font_cfg->FontDataOwnedByAtlas to false to keep ownership.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_font_data, int compressed_font_size, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // 'compressed_font_data' still owned by caller. Compress with binary_to_compressed_c.cpp.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedBase85TTF(const char* compressed_font_data_base85, float size_pixels, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);              // 'compressed_font_data_base85' still owned by caller. Compress with binary_to_compressed_c.cpp with -base85 parameter.
+    IMGUI_API bool              AddFontsFromMemoryBakedAtlas(const void* baked_atlas_data, int baked_atlas_size);                      // Load the fonts and texture of a file written by Build() with CacheFilename set, without any TTF parsing nor rasterization. Call on an empty atlas. Data still owned by caller.
+    IMGUI_API bool              AddFontsFromMemoryCompressedBakedAtlas(const void* compressed_baked_atlas_data, int compressed_baked_atlas_size); // Compress with binary_to_compressed_c.cpp with -atlas parameter. The fonts can't be rebuilt: keep the texture data and don't add fonts.
+    IMGUI_API bool              AddFontsFromMemoryCompressedBase85BakedAtlas(const char* compressed_baked_atlas_data_base85);          // Compress with binary_to_compressed_c.cpp with -atlas -base85 parameters.
     IMGUI_API void              ClearInputData();           // Clear input data (all ImFontConfig structures including sizes, TTF data, glyph ranges, etc.) = all the data used to build the texture and fonts.
     IMGUI_API void              ClearTexData();             // Clear output texture data (CPU side). Saves RAM once the texture has been copied to graphics memory.
     IMGUI_API void              ClearFonts();               // Clear output font data (glyphs storage, UV coordinates).
@@ -1704,10 +1883,13 @@ struct ImFontAtlas
     // Build atlas, retrieve pixel data.
     // User is in charge of copying the pixels into graphics memory (e.g. create a texture with your engine). Then store your texture handle with SetTexID().
     // RGBA32 format is provided for convenience and compatibility, but note that unless you use CustomRect to draw color data, the RGB pixels emitted from Fonts will all be white (~75% of waste). 
+    // If your graphics API can swizzle (e.g. GL_TEXTURE_SWIZZLE_RGBA, Vulkan/D3D12 component mapping), upload the Alpha8 data as a single channel texture returning (1,1,1,R) instead.
+    // Otherwise GetTexDataRowsAsRGBA32() avoids keeping the RGBA32 copy in memory, or set ImFontAtlasFlags_DiscardAlpha8 to keep only the RGBA32 copy.
     // Pitch = Width * BytesPerPixels
     IMGUI_API bool              Build();                    // Build pixels data. This is called automatically for you by the GetTexData*** functions.
     IMGUI_API void              GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 1 byte per-pixel
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
+    IMGUI_API void              GetTexDataRowsAsRGBA32(void (*rows_fn)(const unsigned char* pixels, int y, int rows_count, void* user_data), void* user_data, int y_min = 0, int y_max = -1); // 4 bytes-per-pixel, without keeping a RGBA32 copy of the texture: rows [y_min, y_max) are expanded into a small buffer, passed to rows_fn() a band at a time (pitch = TexWidth * 4). Upload each band to your texture. y_max = -1: TexHeight.
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
     //-------------------------------------------
@@ -1768,8 +1950,13 @@ struct ImFontAtlas
 
     ImFontAtlasFlags            Flags;              // Build flags (see ImFontAtlasFlags_)
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
-    int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
+    int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height. 0: pick the width giving the smallest texture.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1.
+    ImVec4                      TexUpdateRect;      // Pixels (x1,y1,x2,y2) written since you last cleared it, with ImFontAtlasFlags_DynamicGlyphs. Empty when x1 >= x2. Upload them to your texture then set to ImVec4(0,0,0,0).
+    void                        (*ParallelForFn)(int tasks_count, void (*task_fn)(void* task_data, int task_n), void* task_data, void* user_data);   // = NULL // Used by Build() (and ImGuiFreeType::BuildFontAtlas()) to rasterize glyphs on multiple threads: call task_fn(task_data, n) for every n in [0, tasks_count), in any order and on any thread, and return once all calls are done. The texture is identical to a serial build. The allocator functions need to be thread-safe.
+    void*                       ParallelForUserData;
+    int                         SDFSpread;          // = 4      // With ImFontAtlasFlags_SDF, distance in texture pixels from the glyph outlines to the 0 and 255 values. Glyphs are padded by as many pixels. Larger values allow outline/glow effects, smaller values keep more precision near the outline.
+    const char*                 CacheFilename;      // = NULL   // Path to a cache file of the atlas. Build() loads the fonts and texture from it when they were built from the same fonts and settings, else builds them and rewrites the file. Ignored with ImFontAtlasFlags_DynamicGlyphs. The file can also be embedded as a baked atlas, see AddFontsFromMemoryCompressedBakedAtlas().
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
@@ -1783,19 +1970,19 @@ struct ImFontAtlas
     ImVector<CustomRect>        CustomRects;        // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Internal data
     int                         CustomRectIds[1];   // Identifiers of custom texture rectangle used by ImFontAtlas/ImDrawList
+    ImFontAtlasDynamicData*     DynamicData;        // Font data and packer kept alive after Build() with ImFontAtlasFlags_DynamicGlyphs
 };
 
 // Font runtime data and rendering
 // ImFontAtlas automatically loads a default embedded font for you when you call GetTexDataAsAlpha8() or GetTexDataAsRGBA32().
 struct ImFont
 {
-    // Members: Hot ~62/78 bytes
+    // Members: Hot ~30/46 bytes + 1/2 KB page table
     float                       FontSize;           // <user set>   // Height of characters, set during loading (don't change after loading)
     float                       Scale;              // = 1.f        // Base font scale, multiplied by the per-window font scale which you can adjust with SetFontScale()
     ImVec2                      DisplayOffset;      // = (0.f,0.f)  // Offset font rendering by xx pixels
     ImVector<ImFontGlyph>       Glyphs;             //              // All glyphs.
-    ImVector<float>             IndexAdvanceX;      //              // Sparse. Glyphs->AdvanceX in a directly indexable way (more cache-friendly, for CalcTextSize functions which are often bottleneck in large UI).
-    ImVector<unsigned short>    IndexLookup;        //              // Sparse. Index glyphs by Unicode code-point.
+    const ImFontIndexPage*      IndexPages[256];    //              // Glyphs->AdvanceX and glyph index by Unicode code-point, in a directly indexable way (more cache-friendly, for CalcTextSize functions which are often bottleneck in large UI). Blocks without glyphs share a read-only empty page.
     const ImFontGlyph*          FallbackGlyph;      // == FindGlyph(FontFallbackChar)
     float                       FallbackAdvanceX;   // == FallbackGlyph->AdvanceX
     ImWchar                     FallbackChar;       // = '?'        // Replacement glyph if one isn't found. Only set via SetFallbackChar()
@@ -1816,7 +2003,7 @@ struct ImFont
     IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;
     IMGUI_API void              SetFallbackChar(ImWchar c);
-    float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
+    float                       GetCharAdvance(ImWchar c) const     { float advance_x = IndexPages[c >> 8]->AdvanceX[c & 0xFF]; return (advance_x >= 0.0f) ? advance_x : const_cast<ImFont*>(this)->LoadGlyphAdvanceX(c); }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
     const char*                 GetDebugName() const                { return ConfigData ? ConfigData->Name : "<unknown>"; }
 
@@ -1828,9 +2015,11 @@ struct ImFont
     IMGUI_API void              RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width = 0.0f, bool cpu_fine_clip = false) const;
 
     // [Internal]
-    IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API ImFontIndexPage*  AllocIndexPage(ImWchar c);      // Give the block of 'c' its own page in IndexPages[] if it uses the empty page
     IMGUI_API void              AddGlyph(ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
+    IMGUI_API const ImFontGlyph*LoadGlyph(ImWchar c);           // Called on code points with a negative AdvanceX in IndexPages[]: rasterize the glyph with ImFontAtlasFlags_DynamicGlyphs. NULL if the font has none.
+    IMGUI_API float             LoadGlyphAdvanceX(ImWchar c);   // LoadGlyph(c)->AdvanceX, or FallbackAdvanceX
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     typedef ImFontGlyph Glyph; // OBSOLETE 1.52+
@@ -791,6 +791,8 @@ void ImGui::ShowDemoWindow(bool* p_open)
         {
             static bool animate = true;
             ImGui::Checkbox("Animate", &animate);
+            if (animate)
+                ImGui::RequestFrame(); // Keep updating when the application only renders on inputs (see io.WantNextFrame)
 
             static float arr[] = { 0.6f, 0.1f, 1.0f, 0.5f, 0.92f, 0.1f, 0.2f };
             ImGui::PlotLines("Frame Times", arr, IM_ARRAYSIZE(arr));
@@ -2513,6 +2515,7 @@ static void ShowExampleAppWindowTitles(bool*)
     // Using "###" to display a changing title but keep a static identifier "AnimatedTitle"
     char buf[128];
     sprintf(buf, "Animated title %c %d###AnimatedTitle", "|/-\\"[(int)(ImGui::GetTime()/0.25f)&3], ImGui::GetFrameCount());
+    ImGui::RequestFrame(0.25f - fmodf(ImGui::GetTime(), 0.25f));
     ImGui::SetNextWindowPos(ImVec2(100,300), ImGuiCond_FirstUseEver);
     ImGui::Begin(buf);
     ImGui::Text("This window has a changing title.");
@@ -3006,6 +3009,7 @@ static void ShowExampleAppLog(bool* p_open)
         log.AddLog("[%s] Hello, time is %.1f, frame count is %d\n", random_words[rand() % IM_ARRAYSIZE(random_words)], time, ImGui::GetFrameCount());
         last_time = time;
     }
+    ImGui::RequestFrame(0.20f - (time - last_time));
 
     log.Draw("Example: Log", p_open);
 }
@@ -101,9 +101,10 @@ namespace IMGUI_STB_NAMESPACE
 #include "stb_rect_pack.h"
 #endif
 
+#ifndef IMGUI_DISABLE_STB_TRUETYPE
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
-#define STBTT_malloc(x,u)  ((void)(u), ImGui::MemAlloc(x))
-#define STBTT_free(x,u)    ((void)(u), ImGui::MemFree(x))
+#define STBTT_malloc(x,u)  ((u) ? ImGui::MemAllocThreadSafe(x) : ImGui::MemAlloc(x))    // u != NULL: glyphs rasterized by a Build() task, see ImFontAtlasBuildRasterTask()
+#define STBTT_free(x,u)    ((u) ? ImGui::MemFreeThreadSafe(x) : ImGui::MemFree(x))
 #define STBTT_assert(x)    IM_ASSERT(x)
 #define STBTT_STATIC
 #define STB_TRUETYPE_IMPLEMENTATION
@@ -115,6 +116,7 @@ namespace IMGUI_STB_NAMESPACE
 #else
 #include "stb_truetype.h"
 #endif
+#endif
 
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
@@ -297,6 +299,7 @@ ImDrawListSharedData::ImDrawListSharedData()
     FontSize = 0.0f;
     CurveTessellationTol = 0.0f;
     ClipRectFullscreen = ImVec4(-8192.0f, -8192.0f, +8192.0f, +8192.0f);
+    ShapeCacheMaxCount = 512;
     
     // Const data
     for (int i = 0; i < IM_ARRAYSIZE(CircleVtx12); i++)
@@ -347,6 +350,9 @@ void ImDrawList::ClearFreeMemory()
         _Channels[i].IdxBuffer.clear();
     }
     _Channels.clear();
+    if (_ShapeCache)
+        IM_DELETE(_ShapeCache);
+    _ShapeCache = NULL;
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
@@ -365,6 +371,7 @@ ImDrawList* ImDrawList::CloneOutput() const
 
 void ImDrawList::AddDrawCmd()
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = GetCurrentClipRect();
     draw_cmd.TextureId = GetCurrentTextureId();
@@ -433,6 +440,7 @@ void ImDrawList::UpdateTextureID()
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(ImVec2 cr_min, ImVec2 cr_max, bool intersect_with_current_clip_rect)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect && _ClipRectStack.Size)
     {
@@ -463,6 +471,7 @@ void ImDrawList::PopClipRect()
 
 void ImDrawList::PushTextureID(ImTextureID texture_id)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     _TextureIdStack.push_back(texture_id);
     UpdateTextureID();
 }
@@ -476,6 +485,7 @@ void ImDrawList::PopTextureID()
 
 void ImDrawList::ChannelsSplit(int channels_count)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     IM_ASSERT(_ChannelsCurrent == 0 && _ChannelsCount == 1);
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -556,6 +566,7 @@ void ImDrawList::ChannelsSetCurrent(int idx)
 // NB: this can be called with negative count for removing primitives (as long as the result does not underflow)
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     ImDrawCmd& draw_cmd = CmdBuffer.Data[CmdBuffer.Size-1];
     draw_cmd.ElemCount += idx_count;
 
@@ -779,10 +790,10 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 
             const float dx = diff.x * (thickness * 0.5f);
             const float dy = diff.y * (thickness * 0.5f);
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr[0].pos = ImVec2(p1.x + dy, p1.y - dx); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = ImVec2(p2.x + dy, p2.y - dx); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = ImVec2(p2.x - dy, p2.y + dx); _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = ImVec2(p1.x - dy, p1.y + dx); _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
             _VtxWritePtr += 4;
 
             _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx+1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx+2);
@@ -876,6 +887,7 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
 
 void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int a_min_of_12, int a_max_of_12)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     if (radius == 0.0f || a_min_of_12 > a_max_of_12)
     {
         _Path.push_back(centre);
@@ -891,6 +903,7 @@ void ImDrawList::PathArcToFast(const ImVec2& centre, float radius, int a_min_of_
 
 void ImDrawList::PathArcTo(const ImVec2& centre, float radius, float a_min, float a_max, int num_segments)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     if (radius == 0.0f)
     {
         _Path.push_back(centre);
@@ -904,54 +917,56 @@ void ImDrawList::PathArcTo(const ImVec2& centre, float radius, float a_min, floa
     }
 }
 
-static void PathBezierToCasteljau(ImVector<ImVec2>* path, float x1, float y1, float x2, float y2, float x3, float y3, float x4, float y4, float tess_tol, int level)
+// Estimate the number of segments needed to flatten a cubic bezier curve from its control polygon (Wang's formula).
+// The distance between the curve and the polyline is kept under tess_tol*0.5f, which matches the quality of the former recursive subdivision.
+static int PathBezierCalcSegmentCount(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, float tess_tol)
 {
-    float dx = x4 - x1;
-    float dy = y4 - y1;
-    float d2 = ((x2 - x4) * dy - (y2 - y4) * dx);
-    float d3 = ((x3 - x4) * dy - (y3 - y4) * dx);
-    d2 = (d2 >= 0) ? d2 : -d2;
-    d3 = (d3 >= 0) ? d3 : -d3;
-    if ((d2+d3) * (d2+d3) < tess_tol * (dx*dx + dy*dy))
-    {
-        path->push_back(ImVec2(x4, y4));
-    }
-    else if (level < 10)
-    {
-        float x12 = (x1+x2)*0.5f,       y12 = (y1+y2)*0.5f;
-        float x23 = (x2+x3)*0.5f,       y23 = (y2+y3)*0.5f;
-        float x34 = (x3+x4)*0.5f,       y34 = (y3+y4)*0.5f;
-        float x123 = (x12+x23)*0.5f,    y123 = (y12+y23)*0.5f;
-        float x234 = (x23+x34)*0.5f,    y234 = (y23+y34)*0.5f;
-        float x1234 = (x123+x234)*0.5f, y1234 = (y123+y234)*0.5f;
+    const ImVec2 d1(p1.x - 2.0f * p2.x + p3.x, p1.y - 2.0f * p2.y + p3.y);
+    const ImVec2 d2(p2.x - 2.0f * p3.x + p4.x, p2.y - 2.0f * p3.y + p4.y);
+    if (tess_tol <= 0.0f)
+        return 1024;    // Deepest level of the former recursive subdivision
+    const float m = sqrtf(ImMax(ImLengthSqr(d1), ImLengthSqr(d2)));
+    const float num_segments = ImMin(sqrtf(0.75f * m / (tess_tol * 0.5f)) + 1.0f, 1024.0f);  // Clamp before converting: huge or NaN values
+    return ImMax((int)num_segments, 1);
+}
 
-        PathBezierToCasteljau(path, x1,y1,        x12,y12,    x123,y123,  x1234,y1234, tess_tol, level+1);
-        PathBezierToCasteljau(path, x1234,y1234,  x234,y234,  x34,y34,    x4,y4,       tess_tol, level+1);
+// Evaluate the curve at regular intervals using forward differencing, writing into the path with a single resize.
+static void PathBezierCubicCurveTo(ImVector<ImVec2>* path, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments)
+{
+    IM_ASSERT(num_segments > 0);
+
+    // Polynomial coefficients: B(t) = a*t^3 + b*t^2 + c*t + p1
+    const ImVec2 a(p4.x - p1.x + 3.0f * (p2.x - p3.x), p4.y - p1.y + 3.0f * (p2.y - p3.y));
+    const ImVec2 b(3.0f * (p1.x - 2.0f * p2.x + p3.x), 3.0f * (p1.y - 2.0f * p2.y + p3.y));
+    const ImVec2 c(3.0f * (p2.x - p1.x), 3.0f * (p2.y - p1.y));
+    const float h = 1.0f / (float)num_segments, h2 = h * h, h3 = h2 * h;
+
+    float fx = p1.x, fy = p1.y;
+    float dfx = a.x * h3 + b.x * h2 + c.x * h, dfy = a.y * h3 + b.y * h2 + c.y * h;
+    float ddfx = 6.0f * a.x * h3 + 2.0f * b.x * h2, ddfy = 6.0f * a.y * h3 + 2.0f * b.y * h2;
+    const float dddfx = 6.0f * a.x * h3, dddfy = 6.0f * a.y * h3;
+
+    const int path_old_size = path->Size;
+    path->resize(path_old_size + num_segments);
+    ImVec2* out = path->Data + path_old_size;
+    for (int i_step = 1; i_step < num_segments; i_step++)
+    {
+        fx += dfx; dfx += ddfx; ddfx += dddfx;
+        fy += dfy; dfy += ddfy; ddfy += dddfy;
+        *out++ = ImVec2(fx, fy);
     }
+    *out = p4;  // Avoid accumulated error on the end point
 }
 
 void ImDrawList::PathBezierCurveTo(const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, int num_segments)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
     ImVec2 p1 = _Path.back();
+    if (num_segments < 0)
+        return;
     if (num_segments == 0)
-    {
-        // Auto-tessellated
-        PathBezierToCasteljau(&_Path, p1.x, p1.y, p2.x, p2.y, p3.x, p3.y, p4.x, p4.y, _Data->CurveTessellationTol, 0);
-    }
-    else
-    {
-        float t_step = 1.0f / (float)num_segments;
-        for (int i_step = 1; i_step <= num_segments; i_step++)
-        {
-            float t = t_step * i_step;
-            float u = 1.0f - t;
-            float w1 = u*u*u;
-            float w2 = 3*u*u*t;
-            float w3 = 3*u*t*t;
-            float w4 = t*t*t;
-            _Path.push_back(ImVec2(w1*p1.x + w2*p2.x + w3*p3.x + w4*p4.x, w1*p1.y + w2*p2.y + w3*p3.y + w4*p4.y));
-        }
-    }
+        num_segments = PathBezierCalcSegmentCount(p1, p2, p3, p4, _Data->CurveTessellationTol); // Auto-tessellated
+    PathBezierCubicCurveTo(&_Path, p1, p2, p3, p4, num_segments);
 }
 
 void ImDrawList::PathRect(const ImVec2& a, const ImVec2& b, float rounding, int rounding_corners)
@@ -988,15 +1003,105 @@ void ImDrawList::AddLine(const ImVec2& a, const ImVec2& b, ImU32 col, float thic
     PathStroke(col, false, thickness);
 }
 
+static ImDrawListShapeKey MakeShapeKey(const ImDrawList* draw_list, const ImVec2& size, float rounding, int rounding_corners_flags, float thickness)
+{
+    ImDrawListShapeKey key;
+    key.Size = size;
+    key.Rounding = rounding;
+    key.Thickness = thickness;
+    key.Flags = (rounding_corners_flags & ImDrawCornerFlags_All) | ((draw_list->Flags & (ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill)) << 4);
+    return key;
+}
+
+// Emit a shape from the tessellation cache at 'pos'. Return false if the shape is not in the cache.
+static bool PrimShapeFromCache(ImDrawList* draw_list, const ImDrawListShapeKey& key, const ImVec2& pos, ImU32 col)
+{
+    const ImDrawListShapeCache* cache = draw_list->_ShapeCache;
+    if (cache == NULL)
+        return false;
+    const int shape_n = cache->Map.GetInt(ImHash(&key, sizeof(key), 0), 0) - 1;
+    if (shape_n < 0 || memcmp(&cache->Shapes[shape_n].Key, &key, sizeof(key)) != 0)
+        return false;
+
+    const ImDrawListCachedShape& shape = cache->Shapes[shape_n];
+    draw_list->PrimReserve(shape.IdxCount, shape.VtxCount);
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+    const ImVec2* src_pos = cache->VtxPos.Data + shape.VtxOffset;
+    const unsigned char* src_opaque = cache->VtxOpaque.Data + shape.VtxOffset;
+    for (int i = 0; i < shape.VtxCount; i++)
+    {
+        draw_list->_VtxWritePtr[i].pos = ImVec2(pos.x + src_pos[i].x, pos.y + src_pos[i].y);
+        draw_list->_VtxWritePtr[i].uv = uv;
+        draw_list->_VtxWritePtr[i].col = src_opaque[i] ? col : col_trans;
+    }
+    const ImDrawIdx* src_idx = cache->Idx.Data + shape.IdxOffset;
+    const unsigned int idx_base = draw_list->_VtxCurrentIdx;
+    for (int i = 0; i < shape.IdxCount; i++)
+        draw_list->_IdxWritePtr[i] = (ImDrawIdx)(idx_base + src_idx[i]);
+    draw_list->_VtxWritePtr += shape.VtxCount;
+    draw_list->_IdxWritePtr += shape.IdxCount;
+    draw_list->_VtxCurrentIdx += shape.VtxCount;
+    return true;
+}
+
+// Store the vertices/indices emitted since (vtx_start, idx_start) into the tessellation cache, relative to 'pos'.
+static void PrimShapeAddToCache(ImDrawList* draw_list, const ImDrawListShapeKey& key, const ImVec2& pos, ImU32 col, int vtx_start, int idx_start)
+{
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_DrawList);
+    const int max_count = draw_list->_Data->ShapeCacheMaxCount;
+    if (max_count <= 0)
+        return;
+    if (draw_list->_ShapeCache == NULL)
+        draw_list->_ShapeCache = IM_NEW(ImDrawListShapeCache)();
+    ImDrawListShapeCache* cache = draw_list->_ShapeCache;
+    if (cache->Shapes.Size >= max_count)
+        cache->Clear();
+
+    ImDrawListCachedShape shape;
+    shape.Key = key;
+    shape.VtxOffset = cache->VtxPos.Size;
+    shape.VtxCount = draw_list->VtxBuffer.Size - vtx_start;
+    shape.IdxOffset = cache->Idx.Size;
+    shape.IdxCount = draw_list->IdxBuffer.Size - idx_start;
+    cache->VtxPos.resize(shape.VtxOffset + shape.VtxCount);
+    cache->VtxOpaque.resize(shape.VtxOffset + shape.VtxCount);
+    cache->Idx.resize(shape.IdxOffset + shape.IdxCount);
+    for (int i = 0; i < shape.VtxCount; i++)
+    {
+        const ImDrawVert& v = draw_list->VtxBuffer.Data[vtx_start + i];
+        const ImVec2 v_pos = v.pos;
+        cache->VtxPos.Data[shape.VtxOffset + i] = ImVec2(v_pos.x - pos.x, v_pos.y - pos.y);
+        cache->VtxOpaque.Data[shape.VtxOffset + i] = (v.col == col) ? 1 : 0;
+    }
+    const unsigned int idx_base = draw_list->_VtxCurrentIdx - (unsigned int)shape.VtxCount;
+    for (int i = 0; i < shape.IdxCount; i++)
+        cache->Idx.Data[shape.IdxOffset + i] = (ImDrawIdx)(draw_list->IdxBuffer.Data[idx_start + i] - idx_base);
+
+    cache->Map.SetInt(ImHash(&key, sizeof(key), 0), cache->Shapes.Size + 1);
+    cache->Shapes.push_back(shape);
+}
+
 // a: upper-left, b: lower-right. we don't render 1 px sized rectangles properly.
 void ImDrawList::AddRect(const ImVec2& a, const ImVec2& b, ImU32 col, float rounding, int rounding_corners_flags, float thickness)
 {
     if ((col & IM_COL32_A_MASK) == 0)
         return;
-    if (Flags & ImDrawListFlags_AntiAliasedLines)
-        PathRect(a + ImVec2(0.5f,0.5f), b - ImVec2(0.50f,0.50f), rounding, rounding_corners_flags);
-    else
-        PathRect(a + ImVec2(0.5f,0.5f), b - ImVec2(0.49f,0.49f), rounding, rounding_corners_flags); // Better looking lower-right corner and rounded non-AA shapes.
+    const ImVec2 p_min = a + ImVec2(0.5f,0.5f);
+    const ImVec2 p_max = (Flags & ImDrawListFlags_AntiAliasedLines) ? b - ImVec2(0.50f,0.50f) : b - ImVec2(0.49f,0.49f); // Better looking lower-right corner and rounded non-AA shapes.
+    if (rounding > 0.0f && (rounding_corners_flags & ImDrawCornerFlags_All) != 0)
+    {
+        // Rounded shapes go through the tessellation cache
+        const ImDrawListShapeKey key = MakeShapeKey(this, p_max - p_min, rounding, rounding_corners_flags, thickness);
+        if (PrimShapeFromCache(this, key, p_min, col))
+            return;
+        const int vtx_start = VtxBuffer.Size, idx_start = IdxBuffer.Size;
+        PathRect(p_min, p_max, rounding, rounding_corners_flags);
+        PathStroke(col, true, thickness);
+        PrimShapeAddToCache(this, key, p_min, col, vtx_start, idx_start);
+        return;
+    }
+    PathRect(p_min, p_max, rounding, rounding_corners_flags);
     PathStroke(col, true, thickness);
 }
 
@@ -1006,8 +1111,14 @@ void ImDrawList::AddRectFilled(const ImVec2& a, const ImVec2& b, ImU32 col, floa
         return;
     if (rounding > 0.0f)
     {
+        // Rounded shapes go through the tessellation cache
+        const ImDrawListShapeKey key = MakeShapeKey(this, b - a, rounding, rounding_corners_flags, 0.0f);
+        if (PrimShapeFromCache(this, key, a, col))
+            return;
+        const int vtx_start = VtxBuffer.Size, idx_start = IdxBuffer.Size;
         PathRect(a, b, rounding, rounding_corners_flags);
         PathFillConvex(col);
+        PrimShapeAddToCache(this, key, a, col, vtx_start, idx_start);
     }
     else
     {
@@ -1107,6 +1218,222 @@ void ImDrawList::AddBezierCurve(const ImVec2& pos0, const ImVec2& cp0, const ImV
     PathStroke(col, false, thickness);
 }
 
+// Access n-th element of a user array with a byte stride (stride 0 = same element for all)
+template<typename T>
+static inline const T& ImStridedAt(const T* base, int stride, int n)    { return *(const T*)(const void*)((const char*)base + (size_t)n * stride); }
+
+// Give back the vertices/indices reserved for primitives that were skipped by a batch (fully transparent)
+static void PrimBatchShrinkToWritePtr(ImDrawList* draw_list)
+{
+    const int idx_unused = draw_list->IdxBuffer.Size - (int)(draw_list->_IdxWritePtr - draw_list->IdxBuffer.Data);
+    if (idx_unused == 0)
+        return;
+    draw_list->VtxBuffer.resize((int)(draw_list->_VtxWritePtr - draw_list->VtxBuffer.Data));
+    draw_list->IdxBuffer.resize((int)(draw_list->_IdxWritePtr - draw_list->IdxBuffer.Data));
+    draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size-1].ElemCount -= idx_unused;
+}
+
+// Same output as calling AddLine() 'count' times, without going through the path and with a single reservation.
+void ImDrawList::AddLineBatch(const ImVec2* a, const ImVec2* b, const ImU32* cols, int count, float thickness, int pos_stride, int col_stride)
+{
+    if (count <= 0)
+        return;
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const ImVec2 half_px(0.5f, 0.5f);
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedLines) != 0;
+    const bool thick_line = thickness > 1.0f;
+    const int vtx_per_line = anti_aliased ? (thick_line ? 8 : 6) : 4;
+    const int idx_per_line = anti_aliased ? (thick_line ? 18 : 12) : 6;
+    PrimReserve(count * idx_per_line, count * vtx_per_line);
+
+    const float AA_SIZE = 1.0f;
+    const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+    for (int n = 0; n < count; n++)
+    {
+        const ImU32 col = ImStridedAt(cols, col_stride, n);
+        if ((col & IM_COL32_A_MASK) == 0)
+            continue;
+        const ImVec2 p1 = ImStridedAt(a, pos_stride, n) + half_px;
+        const ImVec2 p2 = ImStridedAt(b, pos_stride, n) + half_px;
+        ImVec2 diff = p2 - p1;
+        diff *= ImInvLength(diff, 1.0f);
+
+        // Normal at the first point, and averaged normal at the second point (matching AddPolyline() rounding)
+        const ImVec2 normal(diff.y, -diff.x);
+        ImVec2 dm = normal;
+        if (anti_aliased)
+        {
+            float dmr2 = dm.x*dm.x + dm.y*dm.y;
+            if (dmr2 > 0.000001f)
+            {
+                float scale = 1.0f / dmr2;
+                if (scale > 100.0f) scale = 100.0f;
+                dm *= scale;
+            }
+        }
+
+        const unsigned int idx1 = _VtxCurrentIdx;
+        if (!anti_aliased)
+        {
+            const float dx = diff.x * (thickness * 0.5f);
+            const float dy = diff.y * (thickness * 0.5f);
+            _VtxWritePtr[0].pos = ImVec2(p1.x + dy, p1.y - dx); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = ImVec2(p2.x + dy, p2.y - dx); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = ImVec2(p2.x - dy, p2.y + dx); _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = ImVec2(p1.x - dy, p1.y + dx); _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+            _IdxWritePtr[0] = (ImDrawIdx)(idx1); _IdxWritePtr[1] = (ImDrawIdx)(idx1+1); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
+            _IdxWritePtr[3] = (ImDrawIdx)(idx1); _IdxWritePtr[4] = (ImDrawIdx)(idx1+2); _IdxWritePtr[5] = (ImDrawIdx)(idx1+3);
+        }
+        else if (!thick_line)
+        {
+            const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+            const ImVec2 dm1 = normal * AA_SIZE;
+            const ImVec2 dm2 = dm * AA_SIZE;
+            const unsigned int idx2 = idx1 + 3;
+            _VtxWritePtr[0].pos = p1;       _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            _VtxWritePtr[1].pos = p1 + dm1; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;
+            _VtxWritePtr[2].pos = p1 - dm1; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col_trans;
+            _VtxWritePtr[3].pos = p2;       _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+            _VtxWritePtr[4].pos = p2 + dm2; _VtxWritePtr[4].uv = uv; _VtxWritePtr[4].col = col_trans;
+            _VtxWritePtr[5].pos = p2 - dm2; _VtxWritePtr[5].uv = uv; _VtxWritePtr[5].col = col_trans;
+            _IdxWritePtr[0] = (ImDrawIdx)(idx2+0); _IdxWritePtr[1] = (ImDrawIdx)(idx1+0); _IdxWritePtr[2] = (ImDrawIdx)(idx1+2);
+            _IdxWritePtr[3] = (ImDrawIdx)(idx1+2); _IdxWritePtr[4] = (ImDrawIdx)(idx2+2); _IdxWritePtr[5] = (ImDrawIdx)(idx2+0);
+            _IdxWritePtr[6] = (ImDrawIdx)(idx2+1); _IdxWritePtr[7] = (ImDrawIdx)(idx1+1); _IdxWritePtr[8] = (ImDrawIdx)(idx1+0);
+            _IdxWritePtr[9] = (ImDrawIdx)(idx1+0); _IdxWritePtr[10]= (ImDrawIdx)(idx2+0); _IdxWritePtr[11]= (ImDrawIdx)(idx2+1);
+        }
+        else
+        {
+            const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+            const ImVec2 dm1_out = normal * (half_inner_thickness + AA_SIZE), dm1_in = normal * half_inner_thickness;
+            const ImVec2 dm2_out = dm * (half_inner_thickness + AA_SIZE), dm2_in = dm * half_inner_thickness;
+            const unsigned int idx2 = idx1 + 4;
+            _VtxWritePtr[0].pos = p1 + dm1_out; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col_trans;
+            _VtxWritePtr[1].pos = p1 + dm1_in;  _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
+            _VtxWritePtr[2].pos = p1 - dm1_in;  _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
+            _VtxWritePtr[3].pos = p1 - dm1_out; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col_trans;
+            _VtxWritePtr[4].pos = p2 + dm2_out; _VtxWritePtr[4].uv = uv; _VtxWritePtr[4].col = col_trans;
+            _VtxWritePtr[5].pos = p2 + dm2_in;  _VtxWritePtr[5].uv = uv; _VtxWritePtr[5].col = col;
+            _VtxWritePtr[6].pos = p2 - dm2_in;  _VtxWritePtr[6].uv = uv; _VtxWritePtr[6].col = col;
+            _VtxWritePtr[7].pos = p2 - dm2_out; _VtxWritePtr[7].uv = uv; _VtxWritePtr[7].col = col_trans;
+            _IdxWritePtr[0]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1+2);
+            _IdxWritePtr[3]  = (ImDrawIdx)(idx1+2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2+2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2+1);
+            _IdxWritePtr[6]  = (ImDrawIdx)(idx2+1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1+1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1+0);
+            _IdxWritePtr[9]  = (ImDrawIdx)(idx1+0); _IdxWritePtr[10] = (ImDrawIdx)(idx2+0); _IdxWritePtr[11] = (ImDrawIdx)(idx2+1);
+            _IdxWritePtr[12] = (ImDrawIdx)(idx2+2); _IdxWritePtr[13] = (ImDrawIdx)(idx1+2); _IdxWritePtr[14] = (ImDrawIdx)(idx1+3);
+            _IdxWritePtr[15] = (ImDrawIdx)(idx1+3); _IdxWritePtr[16] = (ImDrawIdx)(idx2+3); _IdxWritePtr[17] = (ImDrawIdx)(idx2+2);
+        }
+        _VtxWritePtr += vtx_per_line;
+        _IdxWritePtr += idx_per_line;
+        _VtxCurrentIdx += vtx_per_line;
+    }
+    PrimBatchShrinkToWritePtr(this);
+}
+
+// Same output as calling AddRectFilled() with no rounding 'count' times.
+void ImDrawList::AddRectFilledBatch(const ImVec2* a, const ImVec2* b, const ImU32* cols, int count, int pos_stride, int col_stride)
+{
+    if (count <= 0)
+        return;
+
+    PrimReserve(count * 6, count * 4);
+    for (int n = 0; n < count; n++)
+    {
+        const ImU32 col = ImStridedAt(cols, col_stride, n);
+        if ((col & IM_COL32_A_MASK) == 0)
+            continue;
+        PrimRect(ImStridedAt(a, pos_stride, n), ImStridedAt(b, pos_stride, n), col);
+    }
+    PrimBatchShrinkToWritePtr(this);
+}
+
+// Same output as calling AddQuadFilled() 'count' times. Quads are expected to be convex.
+void ImDrawList::AddQuadFilledBatch(const ImVec2* points, const ImU32* cols, int count, int col_stride)
+{
+    if (count <= 0)
+        return;
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        // Anti-aliased Fill (see AddConvexPolyFilled)
+        const float AA_SIZE = 1.0f;
+        PrimReserve(count * 30, count * 8);
+        for (int n = 0; n < count; n++, points += 4)
+        {
+            const ImU32 col = ImStridedAt(cols, col_stride, n);
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
+            const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+            const unsigned int vtx_inner_idx = _VtxCurrentIdx;
+            const unsigned int vtx_outer_idx = _VtxCurrentIdx+1;
+            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+2); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx+4);
+            _IdxWritePtr[3] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[4] = (ImDrawIdx)(vtx_inner_idx+4); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+6);
+            _IdxWritePtr += 6;
+
+            ImVec2 normals[4];
+            for (int i0 = 3, i1 = 0; i1 < 4; i0 = i1++)
+            {
+                ImVec2 diff = points[i1] - points[i0];
+                diff *= ImInvLength(diff, 1.0f);
+                normals[i0].x = diff.y;
+                normals[i0].y = -diff.x;
+            }
+            for (int i0 = 3, i1 = 0; i1 < 4; i0 = i1++)
+            {
+                ImVec2 dm = (normals[i0] + normals[i1]) * 0.5f;
+                float dmr2 = dm.x*dm.x + dm.y*dm.y;
+                if (dmr2 > 0.000001f)
+                {
+                    float scale = 1.0f / dmr2;
+                    if (scale > 100.0f) scale = 100.0f;
+                    dm *= scale;
+                }
+                dm *= AA_SIZE * 0.5f;
+                _VtxWritePtr[0].pos = (points[i1] - dm); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
+                _VtxWritePtr[1].pos = (points[i1] + dm); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+                _VtxWritePtr += 2;
+                _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx+(i1<<1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx+(i0<<1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx+(i0<<1));
+                _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx+(i0<<1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx+(i1<<1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx+(i1<<1));
+                _IdxWritePtr += 6;
+            }
+            _VtxCurrentIdx += 8;
+        }
+    }
+    else
+    {
+        // Non Anti-aliased Fill
+        PrimReserve(count * 6, count * 4);
+        for (int n = 0; n < count; n++, points += 4)
+        {
+            const ImU32 col = ImStridedAt(cols, col_stride, n);
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
+            PrimQuadUV(points[0], points[1], points[2], points[3], uv, uv, uv, uv, col);
+        }
+    }
+    PrimBatchShrinkToWritePtr(this);
+}
+
+// Same output as calling AddRectFilled(centre - size*0.5f, centre + size*0.5f) 'count' times.
+void ImDrawList::AddPointBatch(const ImVec2* centres, const ImU32* cols, int count, float size, int pos_stride, int col_stride)
+{
+    if (count <= 0)
+        return;
+
+    const ImVec2 half_size(size * 0.5f, size * 0.5f);
+    PrimReserve(count * 6, count * 4);
+    for (int n = 0; n < count; n++)
+    {
+        const ImU32 col = ImStridedAt(cols, col_stride, n);
+        if ((col & IM_COL32_A_MASK) == 0)
+            continue;
+        const ImVec2& centre = ImStridedAt(centres, pos_stride, n);
+        PrimRect(centre - half_size, centre + half_size, col);
+    }
+    PrimBatchShrinkToWritePtr(this);
+}
+
 void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end, float wrap_width, const ImVec4* cpu_fine_clip_rect)
 {
     if ((col & IM_COL32_A_MASK) == 0)
@@ -1246,7 +1573,7 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawVert* vert_start, ImDra
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     for (ImDrawVert* vert = vert_start; vert < vert_end; vert++)
     {
-        float d = ImDot(vert->pos - gradient_p0, gradient_extent);
+        float d = ImDot((ImVec2)vert->pos - gradient_p0, gradient_extent);
         float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
         int r = ImLerp((int)(col0 >> IM_COL32_R_SHIFT) & 0xFF, (int)(col1 >> IM_COL32_R_SHIFT) & 0xFF, t);
         int g = ImLerp((int)(col0 >> IM_COL32_G_SHIFT) & 0xFF, (int)(col1 >> IM_COL32_G_SHIFT) & 0xFF, t);
@@ -1263,7 +1590,7 @@ void ImGui::ShadeVertsLinearAlphaGradientForLeftToRightText(ImDrawVert* vert_sta
     int full_alpha_count = 0;
     for (ImDrawVert* vert = vert_end - 1; vert >= vert_start; vert--)
     {
-        float d = (vert->pos.x - gradient_p0_x) * (gradient_extent_x);
+        float d = (((ImVec2)vert->pos).x - gradient_p0_x) * (gradient_extent_x);
         float alpha_mul = 1.0f - ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
         if (alpha_mul >= 1.0f && ++full_alpha_count > 2)
             return; // Early out
@@ -1287,12 +1614,12 @@ void ImGui::ShadeVertsLinearUV(ImDrawVert* vert_start, ImDrawVert* vert_end, con
         const ImVec2 max = ImMax(uv_a, uv_b);
 
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+            vertex->uv = ImClamp(uv_a + ImMul((ImVec2)vertex->pos - a, scale), min, max);
     }
     else
     {
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
+            vertex->uv = uv_a + ImMul((ImVec2)vertex->pos - a, scale);
     }
 }
 
@@ -1316,6 +1643,7 @@ ImFontConfig::ImFontConfig()
     MergeMode = false;
     RasterizerFlags = 0x00;
     RasterizerMultiply = 1.0f;
+    RasterizerScale = 1.0f;
     memset(Name, 0, sizeof(Name));
     DstFont = NULL;
 }
@@ -1372,12 +1700,50 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
     { ImVec2(55,0), ImVec2(17,17), ImVec2( 9, 9) }, // ImGuiMouseCursor_ResizeNWSE
 };
 
+// A glyph which didn't fit into the texture, see ImFont::LoadGlyph()
+struct ImFontAtlasDynamicFailedGlyph
+{
+    ImFont*                     Font;
+    ImWchar                     Codepoint;
+};
+
+#ifndef IMGUI_DISABLE_STB_TRUETYPE
+// State kept after Build() with ImFontAtlasFlags_DynamicGlyphs or ImFontAtlasFlags_IncrementalFonts, to rasterize glyphs on first use and fonts added later
+struct ImFontAtlasDynamicData
+{
+    stbtt_pack_context          PackContext;        // Skyline packer as left by Build(), writing into TexPixelsAlpha8
+    ImVector<stbtt_fontinfo>    FontInfo;           // Parsed font data of each ConfigData[]
+    ImVector<ImFontAtlasDynamicFailedGlyph> PackFailedGlyphs;  // Glyphs which didn't fit since the last NewFrame(), rendered with the fallback glyph
+    int                         PackFailedSurface;  // Sum of their packed surface in pixels, clamped to FONT_ATLAS_DYNAMIC_MAX_SURFACE
+};
+
+// Limits of ImFontAtlasBuildGrowTexture(): 16384x16384 is the maximum texture size of D3D11 and of most OpenGL drivers
+static const int FONT_ATLAS_DYNAMIC_MAX_TEX_SIZE = 1024*16;
+static const int FONT_ATLAS_DYNAMIC_MAX_SURFACE = FONT_ATLAS_DYNAMIC_MAX_TEX_SIZE * FONT_ATLAS_DYNAMIC_MAX_TEX_SIZE;
+#endif
+
+static void ImFontAtlasBuildDynamicShutdown(ImFontAtlas* atlas)
+{
+    if (atlas->DynamicData == NULL)
+        return;
+#ifndef IMGUI_DISABLE_STB_TRUETYPE
+    stbtt_PackEnd(&atlas->DynamicData->PackContext);
+    IM_DELETE(atlas->DynamicData);
+#endif
+    atlas->DynamicData = NULL;
+}
+
 ImFontAtlas::ImFontAtlas()
 {
     Flags = 0x00;
     TexID = NULL;
     TexDesiredWidth = 0;
     TexGlyphPadding = 1;
+    TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+    ParallelForFn = NULL;
+    ParallelForUserData = NULL;
+    SDFSpread = 4;
+    CacheFilename = NULL;
 
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
@@ -1386,6 +1752,7 @@ ImFontAtlas::ImFontAtlas()
     TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     for (int n = 0; n < IM_ARRAYSIZE(CustomRectIds); n++)
         CustomRectIds[n] = -1;
+    DynamicData = NULL;
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -1395,6 +1762,7 @@ ImFontAtlas::~ImFontAtlas()
 
 void    ImFontAtlas::ClearInputData()
 {
+    ImFontAtlasBuildDynamicShutdown(this);
     for (int i = 0; i < ConfigData.Size; i++)
         if (ConfigData[i].FontData && ConfigData[i].FontDataOwnedByAtlas)
         {
@@ -1417,6 +1785,7 @@ void    ImFontAtlas::ClearInputData()
 
 void    ImFontAtlas::ClearTexData()
 {
+    ImFontAtlasBuildDynamicShutdown(this);
     if (TexPixelsAlpha8)
         ImGui::MemFree(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
@@ -1427,6 +1796,7 @@ void    ImFontAtlas::ClearTexData()
 
 void    ImFontAtlas::ClearFonts()
 {
+    ImFontAtlasBuildDynamicShutdown(this);
     for (int i = 0; i < Fonts.Size; i++)
         IM_DELETE(Fonts[i]);
     Fonts.clear();
@@ -1441,6 +1811,15 @@ void    ImFontAtlas::Clear()
 
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    // Extract alpha again if it was discarded by GetTexDataAsRGBA32() (ImFontAtlasFlags_DiscardAlpha8)
+    if (TexPixelsAlpha8 == NULL && TexPixelsRGBA32 != NULL)
+    {
+        ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+        TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc((size_t)(TexWidth * TexHeight));
+        for (int n = 0; n < TexWidth * TexHeight; n++)
+            TexPixelsAlpha8[n] = (unsigned char)(TexPixelsRGBA32[n] >> IM_COL32_A_SHIFT);
+    }
+
     // Build atlas on demand
     if (TexPixelsAlpha8 == NULL)
     {
@@ -1457,6 +1836,7 @@ void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_wid
 
 void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     // Convert to RGBA32 format on demand
     // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
     if (!TexPixelsRGBA32)
@@ -1466,12 +1846,16 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
         if (pixels)
         {
             TexPixelsRGBA32 = (unsigned int*)ImGui::MemAlloc((size_t)(TexWidth * TexHeight * 4));
-            const unsigned char* src = pixels;
-            unsigned int* dst = TexPixelsRGBA32;
-            for (int n = TexWidth * TexHeight; n > 0; n--)
-                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+            ImFontAtlasBuildExpandAlpha8ToRGBA32(TexPixelsRGBA32, pixels, TexWidth * TexHeight);
         }
     }
+    if ((Flags & ImFontAtlasFlags_DiscardAlpha8) && TexPixelsAlpha8 != NULL && TexPixelsRGBA32 != NULL)
+    {
+        // Glyphs rasterized after Build() are written to TexPixelsAlpha8
+        IM_ASSERT(!(Flags & (ImFontAtlasFlags_DynamicGlyphs | ImFontAtlasFlags_IncrementalFonts)) && "ImFontAtlasFlags_DiscardAlpha8 is not compatible with ImFontAtlasFlags_DynamicGlyphs and ImFontAtlasFlags_IncrementalFonts.");
+        ImGui::MemFree(TexPixelsAlpha8);
+        TexPixelsAlpha8 = NULL;
+    }
 
     *out_pixels = (unsigned char*)TexPixelsRGBA32;
     if (out_width) *out_width = TexWidth;
@@ -1479,8 +1863,42 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
     if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
 }
 
+void    ImFontAtlas::GetTexDataRowsAsRGBA32(void (*rows_fn)(const unsigned char* pixels, int y, int rows_count, void* user_data), void* user_data, int y_min, int y_max)
+{
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    if (TexPixelsRGBA32 != NULL)
+    {
+        // Already expanded by GetTexDataAsRGBA32()
+        if (y_max < 0 || y_max > TexHeight)
+            y_max = TexHeight;
+        y_min = ImMax(y_min, 0);
+        if (y_min < y_max)
+            rows_fn((const unsigned char*)(TexPixelsRGBA32 + y_min * TexWidth), y_min, y_max - y_min, user_data);
+        return;
+    }
+    unsigned char* pixels = NULL;
+    GetTexDataAsAlpha8(&pixels, NULL, NULL);
+    if (y_max < 0 || y_max > TexHeight)
+        y_max = TexHeight;
+    y_min = ImMax(y_min, 0);
+    if (pixels == NULL || y_min >= y_max)
+        return;
+
+    // Bands of ~64 KB, at least one row
+    const int band_rows = ImMax(1, (64 * 1024) / (TexWidth * 4));
+    unsigned int* band = (unsigned int*)ImGui::MemAlloc((size_t)(TexWidth * ImMin(band_rows, y_max - y_min) * 4));
+    for (int y = y_min; y < y_max; y += band_rows)
+    {
+        const int rows_count = ImMin(band_rows, y_max - y);
+        ImFontAtlasBuildExpandAlpha8ToRGBA32(band, pixels + y * TexWidth, TexWidth * rows_count);
+        rows_fn((const unsigned char*)band, y, rows_count, user_data);
+    }
+    ImGui::MemFree(band);
+}
+
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
 
@@ -1490,7 +1908,12 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
     else
         IM_ASSERT(!Fonts.empty()); // When using MergeMode make sure that a font has already been added before. You can use ImGui::GetIO().Fonts->AddFontDefault() to add the default imgui font.
 
+    const ImFontConfig* old_config_data = ConfigData.Data;
     ConfigData.push_back(*font_cfg);
+    if (ConfigData.Data != old_config_data)
+        for (int i = 0; i < Fonts.Size; i++)
+            if (Fonts[i]->ConfigData)
+                Fonts[i]->ConfigData = ConfigData.Data + (Fonts[i]->ConfigData - old_config_data);
     ImFontConfig& new_font_cfg = ConfigData.back();
     if (!new_font_cfg.DstFont)
         new_font_cfg.DstFont = Fonts.back();
@@ -1501,8 +1924,9 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
         memcpy(new_font_cfg.FontData, font_cfg->FontData, (size_t)new_font_cfg.FontDataSize);
     }
 
-    // Invalidate texture
-    ClearTexData();
+    // Add to the texture when Build() kept the packer alive (ImFontAtlasFlags_IncrementalFonts), else invalidate it
+    if (DynamicData == NULL || !ImFontAtlasBuildAddFontIncremental(this, &new_font_cfg))
+        ClearTexData();
     return new_font_cfg.DstFont;
 }
 
@@ -1542,6 +1966,7 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 
 ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     int data_size = 0;
     void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
     if (!data)
@@ -1561,6 +1986,7 @@ ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels,
 }
 
 // NB: Transfer ownership of 'ttf_data' to ImFontAtlas, unless font_cfg_template->FontDataOwnedByAtlas == false. Owned TTF buffer will be deleted after Build().
+// The buffer is freed with ImGui::MemFree(), so it needs to be allocated with ImGui::MemAlloc().
 ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
     ImFontConfig font_cfg = font_cfg_template ? *font_cfg_template : ImFontConfig();
@@ -1575,6 +2001,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float si
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     const unsigned int buf_decompressed_size = stb_decompress_length((unsigned char*)compressed_ttf_data);
     unsigned char* buf_decompressed_data = (unsigned char *)ImGui::MemAlloc(buf_decompressed_size);
     stb_decompress(buf_decompressed_data, (unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
@@ -1587,6 +2014,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_d
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed_ttf_data_base85, float size_pixels, const ImFontConfig* font_cfg, const ImWchar* glyph_ranges)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     int compressed_ttf_size = (((int)strlen(compressed_ttf_data_base85) + 4) / 5) * 4;
     void* compressed_ttf = ImGui::MemAlloc((size_t)compressed_ttf_size);
     Decode85((const unsigned char*)compressed_ttf_data_base85, (unsigned char*)compressed_ttf);
@@ -1595,8 +2023,41 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
     return font;
 }
 
+// Load a file written by Build() with CacheFilename set: fonts, glyphs and texture are restored as they were built, without parsing or rasterizing any TTF data
+static bool ImFontAtlasBuildLoadFromMemory(ImFontAtlas* atlas, const unsigned char* data, int data_size, bool add_fonts);
+
+bool ImFontAtlas::AddFontsFromMemoryBakedAtlas(const void* baked_atlas_data, int baked_atlas_size)
+{
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    IM_ASSERT(Fonts.empty() && ConfigData.empty()); // A baked atlas can't be mixed with other fonts, call Clear() first.
+    return ImFontAtlasBuildLoadFromMemory(this, (const unsigned char*)baked_atlas_data, baked_atlas_size, true);
+}
+
+bool ImFontAtlas::AddFontsFromMemoryCompressedBakedAtlas(const void* compressed_baked_atlas_data, int compressed_baked_atlas_size)
+{
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    const unsigned int buf_decompressed_size = stb_decompress_length((unsigned char*)compressed_baked_atlas_data);
+    unsigned char* buf_decompressed_data = (unsigned char *)ImGui::MemAlloc(buf_decompressed_size);
+    stb_decompress(buf_decompressed_data, (unsigned char*)compressed_baked_atlas_data, (unsigned int)compressed_baked_atlas_size);
+    const bool ret = AddFontsFromMemoryBakedAtlas(buf_decompressed_data, (int)buf_decompressed_size);
+    ImGui::MemFree(buf_decompressed_data);
+    return ret;
+}
+
+bool ImFontAtlas::AddFontsFromMemoryCompressedBase85BakedAtlas(const char* compressed_baked_atlas_data_base85)
+{
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    int compressed_size = (((int)strlen(compressed_baked_atlas_data_base85) + 4) / 5) * 4;
+    void* compressed_data = ImGui::MemAlloc((size_t)compressed_size);
+    Decode85((const unsigned char*)compressed_baked_atlas_data_base85, (unsigned char*)compressed_data);
+    const bool ret = AddFontsFromMemoryCompressedBakedAtlas(compressed_data, compressed_size);
+    ImGui::MemFree(compressed_data);
+    return ret;
+}
+
 int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     IM_ASSERT(id >= 0x10000);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
@@ -1610,6 +2071,7 @@ int ImFontAtlas::AddCustomRectRegular(unsigned int id, int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     IM_ASSERT(font != NULL);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
@@ -1655,7 +2117,29 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
-    return ImFontAtlasBuildWithStbTruetype(this);
+    // Fonts loaded from a baked atlas have no font data to build from
+    for (int input_i = 0; input_i < ConfigData.Size; input_i++)
+        if (ConfigData[input_i].FontData == NULL)
+        {
+            IM_ASSERT(0 && "Can't build fonts loaded with AddFontsFromMemoryBakedAtlas(), keep the texture data (don't call ClearTexData()) and don't add fonts.");
+            return false;
+        }
+
+    ImGui::ProfilerPushZone("FontAtlasBuild");
+    const bool use_cache = (CacheFilename != NULL) && !(Flags & ImFontAtlasFlags_DynamicGlyphs);
+    bool ret = use_cache && ImFontAtlasBuildLoadCache(this, CacheFilename);
+    if (!ret)
+    {
+#ifndef IMGUI_DISABLE_STB_TRUETYPE
+        ret = ImFontAtlasBuildWithStbTruetype(this);
+        if (ret && use_cache)
+            ImFontAtlasBuildSaveCache(this, CacheFilename);
+#else
+        IM_ASSERT(0 && "IMGUI_DISABLE_STB_TRUETYPE is defined: load a baked atlas with AddFontsFromMemoryCompressedBakedAtlas() or build with misc/freetype.");
+#endif
+    }
+    ImGui::ProfilerPopZone();
+    return ret;
 }
 
 void    ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_brighten_factor)
@@ -1675,8 +2159,272 @@ void    ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsig
             data[i] = table[data[i]];
 }
 
+// Expand 1 byte coverage to white RGBA32 pixels. The SSE2 path relies on IM_COL32_A_SHIFT == 24, true for both RGBA and BGRA packing.
+void    ImFontAtlasBuildExpandAlpha8ToRGBA32(unsigned int* dst, const unsigned char* src, int count)
+{
+#ifdef IMGUI_ENABLE_SSE
+    // 16 pixels per iteration: interleave 0xFF bytes before each alpha byte (0xAAFF), then 0xFFFF words before those (0xAAFFFFFF)
+    const __m128i white = _mm_set1_epi8((char)0xFF);
+    for (; count >= 16; count -= 16, src += 16, dst += 16)
+    {
+        const __m128i alpha = _mm_loadu_si128((const __m128i*)src);
+        const __m128i alpha_lo = _mm_unpacklo_epi8(white, alpha);
+        const __m128i alpha_hi = _mm_unpackhi_epi8(white, alpha);
+        _mm_storeu_si128((__m128i*)dst + 0, _mm_unpacklo_epi16(white, alpha_lo));
+        _mm_storeu_si128((__m128i*)dst + 1, _mm_unpackhi_epi16(white, alpha_lo));
+        _mm_storeu_si128((__m128i*)dst + 2, _mm_unpacklo_epi16(white, alpha_hi));
+        _mm_storeu_si128((__m128i*)dst + 3, _mm_unpackhi_epi16(white, alpha_hi));
+    }
+#endif
+    for (; count > 0; count--)
+        *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+}
+
+#ifndef IMGUI_DISABLE_STB_TRUETYPE
+
+// Glyphs rasterized by a task of ImFontAtlasBuildWithStbTruetype(). Tasks write to separate rectangles of the texture, so they can run on multiple threads.
+struct ImFontBuildRasterTask
+{
+    int                     ConfigIndex;
+    const stbtt_fontinfo*   FontInfo;
+    int                     RangesStart;    // Index in ImFontBuildRasterTasks::Ranges
+    int                     RangesCount;
+    stbrp_rect*             Rects;
+    int                     RectsCount;
+};
+
+struct ImFontBuildRasterTasks
+{
+    ImFontAtlas*                    Atlas;
+    const stbtt_pack_context*       PackContext;
+    ImVector<ImFontBuildRasterTask> Tasks;
+    ImVector<stbtt_pack_range>      Ranges;     // Slices of the ranges of each font, pointing to the same packed characters
+};
+
+// Same as stbtt_PackFontRangesGatherRects(), with room for the signed distance fields around the glyphs with ImFontAtlasFlags_SDF
+static int ImFontAtlasBuildGatherRects(const ImFontAtlas* atlas, const ImFontConfig& cfg, stbtt_pack_context* spc, const stbtt_fontinfo* info, stbtt_pack_range* ranges, int ranges_count, stbrp_rect* rects)
+{
+    if (!(atlas->Flags & ImFontAtlasFlags_SDF))
+    {
+        stbtt_PackSetOversampling(spc, cfg.OversampleH, cfg.OversampleV);
+        return stbtt_PackFontRangesGatherRects(spc, info, ranges, ranges_count, rects);
+    }
+
+    // Distance fields are interpolated by the texture sampler, oversampling is not needed
+    stbtt_PackSetOversampling(spc, 1, 1);
+    int k = 0;
+    for (int i = 0; i < ranges_count; i++)
+    {
+        stbtt_pack_range& range = ranges[i];
+        const float scale = stbtt_ScaleForPixelHeight(info, range.font_size);
+        range.h_oversample = range.v_oversample = 1;
+        for (int j = 0; j < range.num_chars; j++, k++)
+        {
+            int x0, y0, x1, y1;
+            stbtt_GetGlyphBitmapBox(info, stbtt_FindGlyphIndex(info, range.first_unicode_codepoint_in_range + j), scale, scale, &x0, &y0, &x1, &y1);
+            const bool empty = (x0 == x1 || y0 == y1);  // Same test as stbtt_GetGlyphSDF()
+            rects[k].w = (stbrp_coord)((empty ? 0 : x1 - x0 + atlas->SDFSpread * 2) + spc->padding);
+            rects[k].h = (stbrp_coord)((empty ? 0 : y1 - y0 + atlas->SDFSpread * 2) + spc->padding);
+        }
+    }
+    return k;
+}
+
+// Same as stbtt_PackFontRangesRenderIntoRects() followed by RasterizerMultiply, or render signed distance fields with ImFontAtlasFlags_SDF
+static void ImFontAtlasBuildRenderRects(const ImFontAtlas* atlas, const ImFontConfig& cfg, stbtt_pack_context* spc, const stbtt_fontinfo* info, stbtt_pack_range* ranges, int ranges_count, stbrp_rect* rects)
+{
+    if (!(atlas->Flags & ImFontAtlasFlags_SDF))
+    {
+        stbtt_PackFontRangesRenderIntoRects(spc, info, ranges, ranges_count, rects);
+        if (cfg.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            int rects_count = 0;
+            for (int i = 0; i < ranges_count; i++)
+                rects_count += ranges[i].num_chars;
+            for (const stbrp_rect* r = rects; r != rects + rects_count; r++)
+                if (r->was_packed)
+                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, spc->pixels, r->x, r->y, r->w, r->h, spc->stride_in_bytes);
+        }
+        return;
+    }
+
+    const float pixel_dist_scale = 128.0f / atlas->SDFSpread;
+    int k = 0;
+    for (int i = 0; i < ranges_count; i++)
+    {
+        stbtt_pack_range& range = ranges[i];
+        const float scale = stbtt_ScaleForPixelHeight(info, range.font_size);
+        for (int j = 0; j < range.num_chars; j++, k++)
+        {
+            stbrp_rect* r = &rects[k];
+            if (!r->was_packed)
+                continue;
+
+            // Pad on left and top, like stb_truetype
+            const stbrp_coord pad = (stbrp_coord)spc->padding;
+            r->x += pad;
+            r->y += pad;
+            r->w -= pad;
+            r->h -= pad;
+            const int glyph = stbtt_FindGlyphIndex(info, range.first_unicode_codepoint_in_range + j);
+            int advance, lsb, w = 0, h = 0, xoff = 0, yoff = 0;
+            stbtt_GetGlyphHMetrics(info, glyph, &advance, &lsb);
+            if (unsigned char* sdf = stbtt_GetGlyphSDF(info, scale, glyph, atlas->SDFSpread, 128, pixel_dist_scale, &w, &h, &xoff, &yoff))
+            {
+                IM_ASSERT(w == r->w && h == r->h);
+                for (int y = 0; y < h; y++)
+                    memcpy(spc->pixels + r->x + (r->y + y) * spc->stride_in_bytes, sdf + y * w, (size_t)w);
+                stbtt_FreeSDF(sdf, info->userdata);
+            }
+
+            stbtt_packedchar* bc = &range.chardata_for_range[j];
+            bc->x0 = (stbtt_int16)r->x;
+            bc->y0 = (stbtt_int16)r->y;
+            bc->x1 = (stbtt_int16)(r->x + w);
+            bc->y1 = (stbtt_int16)(r->y + h);
+            bc->xadvance = scale * advance;
+            bc->xoff = (float)xoff;
+            bc->yoff = (float)yoff;
+            bc->xoff2 = (float)(xoff + w);
+            bc->yoff2 = (float)(yoff + h);
+        }
+    }
+}
+
+static void ImFontAtlasBuildRasterTask(void* task_data, int task_n)
+{
+    ImFontBuildRasterTasks* tasks = (ImFontBuildRasterTasks*)task_data;
+    const ImFontBuildRasterTask& task = tasks->Tasks[task_n];
+    stbtt_pack_context spc = *tasks->PackContext; // Copy, as the oversampling values are modified while rendering
+    ImFontAtlasBuildRenderRects(tasks->Atlas, tasks->Atlas->ConfigData[task.ConfigIndex], &spc, task.FontInfo, &tasks->Ranges[task.RangesStart], task.RangesCount, task.Rects);
+}
+
+// Setup cfg.DstFont and register the glyphs packed and rendered for ranges[] (third pass of ImFontAtlasBuildWithStbTruetype())
+static void ImFontAtlasBuildSetupFontGlyphs(ImFontAtlas* atlas, ImFontConfig& cfg, const stbtt_fontinfo* font_info, const stbtt_pack_range* ranges, int ranges_count)
+{
+    ImFont* dst_font = cfg.DstFont; // We can have multiple input fonts writing into a same destination font (when using MergeMode=true)
+    if (cfg.MergeMode)
+        dst_font->BuildLookupTable();
+
+    const float font_scale = stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels);
+    int unscaled_ascent, unscaled_descent, unscaled_line_gap;
+    stbtt_GetFontVMetrics(font_info, &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
+
+    const float ascent = ImFloor(unscaled_ascent * font_scale + ((unscaled_ascent > 0.0f) ? +1 : -1));
+    const float descent = ImFloor(unscaled_descent * font_scale + ((unscaled_descent > 0.0f) ? +1 : -1));
+    ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ascent, descent);
+    const float off_x = cfg.GlyphOffset.x;
+    const float off_y = cfg.GlyphOffset.y + (float)(int)(dst_font->Ascent + 0.5f);
+    const float rasterizer_scale_inv = 1.0f / cfg.RasterizerScale;
+
+    for (int i = 0; i < ranges_count; i++)
+    {
+        const stbtt_pack_range& range = ranges[i];
+        for (int char_idx = 0; char_idx < range.num_chars; char_idx += 1)
+        {
+            const stbtt_packedchar& pc = range.chardata_for_range[char_idx];
+            if (!pc.x0 && !pc.x1 && !pc.y0 && !pc.y1)
+                continue;
+
+            const int codepoint = range.first_unicode_codepoint_in_range + char_idx;
+            if (cfg.MergeMode && dst_font->FindGlyphNoFallback((unsigned short)codepoint))
+                continue;
+
+            stbtt_aligned_quad q;
+            float dummy_x = 0.0f, dummy_y = 0.0f;
+            stbtt_GetPackedQuad(range.chardata_for_range, atlas->TexWidth, atlas->TexHeight, char_idx, &dummy_x, &dummy_y, &q, 0);
+            dst_font->AddGlyph((ImWchar)codepoint, q.x0 * rasterizer_scale_inv + off_x, q.y0 * rasterizer_scale_inv + off_y, q.x1 * rasterizer_scale_inv + off_x, q.y1 * rasterizer_scale_inv + off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance * rasterizer_scale_inv);
+        }
+    }
+}
+
+// Find the power of two texture width giving the smallest texture, by packing the rectangles as ImFontAtlasBuildWithStbTruetype() does: custom rectangles first, then all glyphs in one call.
+// Once sorted by height, glyphs fill the skyline very well and most of the waste comes from rounding the height up, so only widths around a square texture are tried. Ties go to the squarer texture.
+static int ImFontAtlasBuildFindTexWidth(const ImFontAtlas* atlas, const stbrp_rect* glyph_rects, int glyph_rects_count)
+{
+    const int max_tex_height = 1024*32;
+    const int padding = atlas->TexGlyphPadding;
+    const bool pow2_height = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) == 0;
+    int max_rect_w = 0, max_rect_h = 0, total_surface = 0;
+    for (int n = 0; n < atlas->CustomRects.Size; n++)
+    {
+        max_rect_w = ImMax(max_rect_w, (int)atlas->CustomRects[n].Width);
+        max_rect_h = ImMax(max_rect_h, (int)atlas->CustomRects[n].Height);
+        total_surface += atlas->CustomRects[n].Width * atlas->CustomRects[n].Height;
+    }
+    for (int n = 0; n < glyph_rects_count; n++)
+    {
+        max_rect_w = ImMax(max_rect_w, (int)glyph_rects[n].w);
+        max_rect_h = ImMax(max_rect_h, (int)glyph_rects[n].h);
+        total_surface += glyph_rects[n].w * glyph_rects[n].h;
+    }
+
+    // Candidate widths: from half to twice the width of a square texture
+    const int square_width = (int)sqrtf((float)total_surface);
+    int widths[5];
+    int widths_count = 0;
+    for (int tex_width = 256; tex_width <= 4096; tex_width *= 2)
+        if (tex_width - padding >= max_rect_w && (tex_width >= square_width / 2 || tex_width == 4096) && (tex_width <= square_width * 2 || widths_count == 0))
+            widths[widths_count++] = tex_width;
+    if (widths_count <= 1)
+        return (widths_count == 1) ? widths[0] : atlas->TexWidth;
+
+    ImVector<stbrp_rect> rects;
+    ImVector<stbrp_node> nodes;
+    rects.resize(ImMax(atlas->CustomRects.Size, glyph_rects_count));
+    int best_width = atlas->TexWidth, best_height = 0;
+    for (int width_n = 0; width_n < widths_count; width_n++)
+    {
+        const int tex_width = widths[width_n];
+
+        // Skip widths which can't beat the best texture found so far, even with perfect packing
+        int min_height = ImMax((total_surface + tex_width - padding - 1) / (tex_width - padding), max_rect_h);
+        min_height = pow2_height ? ImUpperPowerOfTwo(min_height) : (min_height + 1);
+        if (best_height != 0 && tex_width * min_height > best_width * best_height)
+            continue;
+
+        nodes.resize(tex_width - padding);
+        stbrp_context context;
+        stbrp_init_target(&context, tex_width - padding, max_tex_height - padding, nodes.Data, nodes.Size);
+
+        // Custom rectangles, as ImFontAtlasBuildPackCustomRects()
+        memset(rects.Data, 0, sizeof(stbrp_rect) * atlas->CustomRects.Size);
+        for (int n = 0; n < atlas->CustomRects.Size; n++)
+        {
+            rects[n].w = atlas->CustomRects[n].Width;
+            rects[n].h = atlas->CustomRects[n].Height;
+        }
+        bool all_packed = stbrp_pack_rects(&context, rects.Data, atlas->CustomRects.Size) != 0;
+        int tex_height = 0;
+        for (int n = 0; n < atlas->CustomRects.Size; n++)
+            tex_height = ImMax(tex_height, rects[n].y + rects[n].h);
+
+        // Glyphs
+        memcpy(rects.Data, glyph_rects, sizeof(stbrp_rect) * glyph_rects_count);
+        if (all_packed)
+            all_packed = stbrp_pack_rects(&context, rects.Data, glyph_rects_count) != 0;
+        if (!all_packed)
+            continue;
+        for (int n = 0; n < glyph_rects_count; n++)
+            tex_height = ImMax(tex_height, rects[n].y + rects[n].h);
+
+        // Same rounding as ImFontAtlasBuildWithStbTruetype()
+        tex_height = pow2_height ? ImUpperPowerOfTwo(tex_height) : (tex_height + 1);
+        const int surface = tex_width * tex_height, best_surface = best_width * best_height;
+        if (best_height == 0 || surface < best_surface || (surface == best_surface && ImMax(tex_width, tex_height) < ImMax(best_width, best_height)))
+        {
+            best_width = tex_width;
+            best_height = tex_height;
+        }
+    }
+    return best_width;
+}
+
 bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     IM_ASSERT(atlas->ConfigData.Size > 0);
 
     ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
@@ -1685,22 +2433,52 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     atlas->TexWidth = atlas->TexHeight = 0;
     atlas->TexUvScale = ImVec2(0.0f, 0.0f);
     atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
+    atlas->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
     atlas->ClearTexData();
 
-    // Count glyphs/ranges
-    int total_glyphs_count = 0;
-    int total_ranges_count = 0;
+    // Select the ranges to rasterize now. With ImFontAtlasFlags_DynamicGlyphs only keep their Basic Latin + Latin Supplement part, other glyphs are rasterized on first use by ImFont::LoadGlyph().
+    const bool dynamic_glyphs = (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) != 0;
+    const ImWchar dynamic_glyphs_prebuilt_max = 0xFF;
+    ImVector<const ImWchar*> build_ranges;
+    ImVector<ImWchar> build_ranges_dynamic;
+    build_ranges.resize(atlas->ConfigData.Size);
+    int build_ranges_dynamic_size = 0;
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
         ImFontConfig& cfg = atlas->ConfigData[input_i];
         if (!cfg.GlyphRanges)
             cfg.GlyphRanges = atlas->GetGlyphRangesDefault();
-        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1]; in_range += 2, total_ranges_count++)
-            total_glyphs_count += (in_range[1] - in_range[0]) + 1;
+        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1]; in_range += 2)
+            build_ranges_dynamic_size += 2;
+        build_ranges_dynamic_size += 1;
+    }
+    if (dynamic_glyphs)
+        build_ranges_dynamic.reserve(build_ranges_dynamic_size);
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        ImFontConfig& cfg = atlas->ConfigData[input_i];
+        build_ranges[input_i] = cfg.GlyphRanges;
+        if (!dynamic_glyphs)
+            continue;
+        build_ranges[input_i] = build_ranges_dynamic.Data + build_ranges_dynamic.Size; // Storage was reserved above
+        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1]; in_range += 2)
+            if (in_range[0] <= dynamic_glyphs_prebuilt_max)
+            {
+                build_ranges_dynamic.push_back(in_range[0]);
+                build_ranges_dynamic.push_back(ImMin(in_range[1], dynamic_glyphs_prebuilt_max));
+            }
+        build_ranges_dynamic.push_back(0);
     }
 
-    // We need a width for the skyline algorithm. Using a dumb heuristic here to decide of width. User can override TexDesiredWidth and TexGlyphPadding if they wish.
-    // Width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
+    // Count glyphs/ranges
+    int total_glyphs_count = 0;
+    int total_ranges_count = 0;
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+        for (const ImWchar* in_range = build_ranges[input_i]; in_range[0] && in_range[1]; in_range += 2, total_ranges_count++)
+            total_glyphs_count += (in_range[1] - in_range[0]) + 1;
+
+    // We need a width for the skyline algorithm. Start with a dumb heuristic, replaced by ImFontAtlasBuildFindTexWidth() below. User can override TexDesiredWidth and TexGlyphPadding if they wish.
+    // Some API/GPU have texture size limitations and increasing width can decrease height.
     atlas->TexWidth = (atlas->TexDesiredWidth > 0) ? atlas->TexDesiredWidth : (total_glyphs_count > 4000) ? 4096 : (total_glyphs_count > 2000) ? 2048 : (total_glyphs_count > 1000) ? 1024 : 512;
     atlas->TexHeight = 0;
 
@@ -1711,9 +2489,6 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         return false;
     stbtt_PackSetOversampling(&spc, 1, 1);
 
-    // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
-
     // Initialize font information (so we can error without any cleanup)
     struct ImFontTempBuildData
     {
@@ -1749,7 +2524,7 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_rects, 0, total_glyphs_count * sizeof(stbrp_rect));              // Unnecessary but let's clear this for the sake of sanity.
     memset(buf_ranges, 0, total_ranges_count * sizeof(stbtt_pack_range));
 
-    // First font pass: pack all glyphs (no rendering at this point, we are working with rectangles in an infinitely tall texture at this point)
+    // First font pass: gather the rectangles of all glyphs (no rendering at this point)
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
         ImFontConfig& cfg = atlas->ConfigData[input_i];
@@ -1758,40 +2533,57 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         // Setup ranges
         int font_glyphs_count = 0;
         int font_ranges_count = 0;
-        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1]; in_range += 2, font_ranges_count++)
+        for (const ImWchar* in_range = build_ranges[input_i]; in_range[0] && in_range[1]; in_range += 2, font_ranges_count++)
             font_glyphs_count += (in_range[1] - in_range[0]) + 1;
         tmp.Ranges = buf_ranges + buf_ranges_n;
         tmp.RangesCount = font_ranges_count;
         buf_ranges_n += font_ranges_count;
         for (int i = 0; i < font_ranges_count; i++)
         {
-            const ImWchar* in_range = &cfg.GlyphRanges[i * 2];
+            const ImWchar* in_range = &build_ranges[input_i][i * 2];
             stbtt_pack_range& range = tmp.Ranges[i];
-            range.font_size = cfg.SizePixels;
+            range.font_size = cfg.SizePixels * cfg.RasterizerScale;
             range.first_unicode_codepoint_in_range = in_range[0];
             range.num_chars = (in_range[1] - in_range[0]) + 1;
             range.chardata_for_range = buf_packedchars + buf_packedchars_n;
             buf_packedchars_n += range.num_chars;
         }
 
-        // Pack
+        // Gather
         tmp.Rects = buf_rects + buf_rects_n;
         tmp.RectsCount = font_glyphs_count;
         buf_rects_n += font_glyphs_count;
-        stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
-        int n = stbtt_PackFontRangesGatherRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
+        int n = ImFontAtlasBuildGatherRects(atlas, cfg, &spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
         IM_ASSERT(n == font_glyphs_count);
-        stbrp_pack_rects((stbrp_context*)spc.pack_info, tmp.Rects, n);
-
-        // Extend texture height
-        for (int i = 0; i < n; i++)
-            if (tmp.Rects[i].was_packed)
-                atlas->TexHeight = ImMax(atlas->TexHeight, tmp.Rects[i].y + tmp.Rects[i].h);
     }
     IM_ASSERT(buf_rects_n == total_glyphs_count);
     IM_ASSERT(buf_packedchars_n == total_glyphs_count);
     IM_ASSERT(buf_ranges_n == total_ranges_count);
 
+    // Pick the width giving the smallest texture. When the packer is kept (ImFontAtlasFlags_DynamicGlyphs or ImFontAtlasFlags_IncrementalFonts) the atlas keeps growing after Build(), a width tuned to the initial glyphs is meaningless: keep the heuristic width.
+    const bool keep_packer = (atlas->Flags & (ImFontAtlasFlags_DynamicGlyphs | ImFontAtlasFlags_IncrementalFonts)) != 0;
+    if (atlas->TexDesiredWidth <= 0 && !keep_packer)
+    {
+        const int tex_width = ImFontAtlasBuildFindTexWidth(atlas, buf_rects, total_glyphs_count);
+        if (tex_width != atlas->TexWidth)
+        {
+            stbtt_PackEnd(&spc);
+            atlas->TexWidth = tex_width;
+            stbtt_PackBegin(&spc, NULL, atlas->TexWidth, max_tex_height, 0, atlas->TexGlyphPadding, NULL);
+        }
+    }
+
+    // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
+    ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
+
+    // Pack the glyphs of all fonts at once, so they are sorted by height together (we are working with rectangles in an infinitely tall texture at this point)
+    stbrp_pack_rects((stbrp_context*)spc.pack_info, buf_rects, total_glyphs_count);
+
+    // Extend texture height
+    for (int i = 0; i < total_glyphs_count; i++)
+        if (buf_rects[i].was_packed)
+            atlas->TexHeight = ImMax(atlas->TexHeight, buf_rects[i].y + buf_rects[i].h);
+
     // Create texture
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
@@ -1800,67 +2592,77 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.pixels = atlas->TexPixelsAlpha8;
     spc.height = atlas->TexHeight;
 
-    // Second pass: render font characters
+    // Second pass: render font characters, split in tasks of up to 'glyphs_per_task' glyphs of a same font, which may run in parallel (see ParallelForFn)
+    const int glyphs_per_task = 64;
+    ImFontBuildRasterTasks tasks;
+    tasks.Atlas = atlas;
+    tasks.PackContext = &spc;
+    tasks.Tasks.reserve(total_glyphs_count / glyphs_per_task + atlas->ConfigData.Size);
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
-        ImFontConfig& cfg = atlas->ConfigData[input_i];
         ImFontTempBuildData& tmp = tmp_array[input_i];
-        stbtt_PackSetOversampling(&spc, cfg.OversampleH, cfg.OversampleV);
-        stbtt_PackFontRangesRenderIntoRects(&spc, &tmp.FontInfo, tmp.Ranges, tmp.RangesCount, tmp.Rects);
-        if (cfg.RasterizerMultiply != 1.0f)
+        tmp.FontInfo.userdata = atlas; // Route stb_truetype allocations to MemAllocThreadSafe()
+        int task_i = -1, rect_n = 0;
+        for (int range_i = 0; range_i < tmp.RangesCount; range_i++)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            for (const stbrp_rect* r = tmp.Rects; r != tmp.Rects + tmp.RectsCount; r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, spc.pixels, r->x, r->y, r->w, r->h, spc.stride_in_bytes);
+            const stbtt_pack_range& range = tmp.Ranges[range_i];
+            for (int char_idx = 0; char_idx < range.num_chars; )
+            {
+                if (task_i == -1 || tasks.Tasks[task_i].RectsCount == glyphs_per_task)
+                {
+                    ImFontBuildRasterTask task = { input_i, &tmp.FontInfo, tasks.Ranges.Size, 0, tmp.Rects + rect_n, 0 };
+                    task_i = tasks.Tasks.Size;
+                    tasks.Tasks.push_back(task);
+                }
+                ImFontBuildRasterTask& task = tasks.Tasks[task_i];
+                const int chars_count = ImMin(range.num_chars - char_idx, glyphs_per_task - task.RectsCount);
+                stbtt_pack_range sub_range = range;
+                sub_range.first_unicode_codepoint_in_range += char_idx;
+                sub_range.chardata_for_range += char_idx;
+                sub_range.num_chars = chars_count;
+                tasks.Ranges.push_back(sub_range);
+                task.RangesCount++;
+                task.RectsCount += chars_count;
+                char_idx += chars_count;
+                rect_n += chars_count;
+            }
         }
-        tmp.Rects = NULL;
+    }
+    if (atlas->ParallelForFn && tasks.Tasks.Size > 1)
+        atlas->ParallelForFn(tasks.Tasks.Size, ImFontAtlasBuildRasterTask, &tasks, atlas->ParallelForUserData);
+    else
+        for (int task_n = 0; task_n < tasks.Tasks.Size; task_n++)
+            ImFontAtlasBuildRasterTask(&tasks, task_n);
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        tmp_array[input_i].FontInfo.userdata = NULL;
+        tmp_array[input_i].Rects = NULL;
     }
 
-    // End packing
-    stbtt_PackEnd(&spc);
+    // End packing (with ImFontAtlasFlags_DynamicGlyphs or ImFontAtlasFlags_IncrementalFonts the packer is kept alive, see below)
+    if (!keep_packer)
+        stbtt_PackEnd(&spc);
     ImGui::MemFree(buf_rects);
     buf_rects = NULL;
 
     // Third pass: setup ImFont and glyphs for runtime
     for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
-        ImFontConfig& cfg = atlas->ConfigData[input_i];
         ImFontTempBuildData& tmp = tmp_array[input_i];
-        ImFont* dst_font = cfg.DstFont; // We can have multiple input fonts writing into a same destination font (when using MergeMode=true)
-        if (cfg.MergeMode)
-            dst_font->BuildLookupTable();
-
-        const float font_scale = stbtt_ScaleForPixelHeight(&tmp.FontInfo, cfg.SizePixels);
-        int unscaled_ascent, unscaled_descent, unscaled_line_gap;
-        stbtt_GetFontVMetrics(&tmp.FontInfo, &unscaled_ascent, &unscaled_descent, &unscaled_line_gap);
-
-        const float ascent = ImFloor(unscaled_ascent * font_scale + ((unscaled_ascent > 0.0f) ? +1 : -1));
-        const float descent = ImFloor(unscaled_descent * font_scale + ((unscaled_descent > 0.0f) ? +1 : -1));
-        ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ascent, descent);
-        const float off_x = cfg.GlyphOffset.x;
-        const float off_y = cfg.GlyphOffset.y + (float)(int)(dst_font->Ascent + 0.5f);
+        ImFontAtlasBuildSetupFontGlyphs(atlas, atlas->ConfigData[input_i], &tmp.FontInfo, tmp.Ranges, tmp.RangesCount);
+    }
 
-        for (int i = 0; i < tmp.RangesCount; i++)
-        {
-            stbtt_pack_range& range = tmp.Ranges[i];
-            for (int char_idx = 0; char_idx < range.num_chars; char_idx += 1)
-            {
-                const stbtt_packedchar& pc = range.chardata_for_range[char_idx];
-                if (!pc.x0 && !pc.x1 && !pc.y0 && !pc.y1)
-                    continue;
-
-                const int codepoint = range.first_unicode_codepoint_in_range + char_idx;
-                if (cfg.MergeMode && dst_font->FindGlyphNoFallback((unsigned short)codepoint))
-                    continue;
-
-                stbtt_aligned_quad q;
-                float dummy_x = 0.0f, dummy_y = 0.0f;
-                stbtt_GetPackedQuad(range.chardata_for_range, atlas->TexWidth, atlas->TexHeight, char_idx, &dummy_x, &dummy_y, &q, 0);
-                dst_font->AddGlyph((ImWchar)codepoint, q.x0 + off_x, q.y0 + off_y, q.x1 + off_x, q.y1 + off_y, q.s0, q.t0, q.s1, q.t1, pc.xadvance);
-            }
-        }
+    // Keep the packer and the parsed fonts to rasterize the other glyphs on first use, or fonts added later
+    if (keep_packer)
+    {
+        ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData = IM_NEW(ImFontAtlasDynamicData)();
+        dynamic_data->PackContext = spc;
+        dynamic_data->PackContext.height = atlas->TexHeight;
+        ((stbrp_context*)spc.pack_info)->height = atlas->TexHeight;
+        dynamic_data->FontInfo.resize(atlas->ConfigData.Size);
+        for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+            dynamic_data->FontInfo[input_i] = tmp_array[input_i].FontInfo;
+        dynamic_data->PackFailedSurface = 0;
     }
 
     // Cleanup temporaries
@@ -1873,6 +2675,8 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     return true;
 }
 
+#endif // #ifndef IMGUI_DISABLE_STB_TRUETYPE
+
 void ImFontAtlasBuildRegisterDefaultCustomRects(ImFontAtlas* atlas)
 {
     if (atlas->CustomRectIds[0] >= 0)
@@ -1978,6 +2782,563 @@ void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
             atlas->Fonts[i]->BuildLookupTable();
 }
 
+// Cache file written after Build() when CacheFilename is set, also loaded as a baked atlas by AddFontsFromMemoryBakedAtlas(). All values are in native byte order:
+//   header: "ImFA", version, inputs hash, Flags, SDFSpread, TexWidth, TexHeight, fonts count, custom rects count
+//   for each font: Name, FontSize, Ascent, Descent, MetricsTotalSurface, DisplayOffset, FallbackChar, glyphs count, glyphs (Codepoint, AdvanceX, X0, Y0, X1, Y1, U0, V0, U1, V1)
+//   for each custom rect: ID, Width, Height, X, Y, GlyphAdvanceX, GlyphOffset, font index (-1 for none)
+//   TexWidth * TexHeight alpha pixels
+static const ImU32 FONT_ATLAS_CACHE_VERSION = 2;
+static const int   FONT_ATLAS_CACHE_FONT_NAME_SIZE = (int)sizeof(((ImFontConfig*)0)->Name);
+static const int   FONT_ATLAS_CACHE_FONT_SIZE = FONT_ATLAS_CACHE_FONT_NAME_SIZE + (int)(5 * sizeof(float) + sizeof(int) + sizeof(ImWchar));   // Without glyphs count and glyphs
+static const int   FONT_ATLAS_CACHE_GLYPH_SIZE = (int)(sizeof(ImWchar) + 9 * sizeof(float));
+static const int   FONT_ATLAS_CACHE_CUSTOM_RECT_SIZE = (int)(sizeof(unsigned int) + 4 * sizeof(unsigned short) + 3 * sizeof(float) + sizeof(int));
+
+static void ImFontAtlasCacheWrite(ImVector<unsigned char>& buf, const void* data, int size)
+{
+    buf.resize(buf.Size + size);
+    memcpy(buf.Data + buf.Size - size, data, (size_t)size);
+}
+
+static bool ImFontAtlasCacheRead(const unsigned char*& p, const unsigned char* p_end, void* out_data, int size)
+{
+    if (p_end - p < size)
+        return false;
+    memcpy(out_data, p, (size_t)size);
+    p += size;
+    return true;
+}
+
+static int ImFontAtlasCacheFindFont(const ImFontAtlas* atlas, const ImFont* font)
+{
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+        if (atlas->Fonts[font_n] == font)
+            return font_n;
+    return -1;
+}
+
+// Hash everything Build() depends on. Called after ImFontAtlasBuildRegisterDefaultCustomRects() and after the default glyph ranges are set.
+static ImU32 ImFontAtlasBuildCalcInputsHash(const ImFontAtlas* atlas)
+{
+    ImU32 seed = ImHash(&FONT_ATLAS_CACHE_VERSION, sizeof(FONT_ATLAS_CACHE_VERSION));
+    seed = ImHash(&atlas->Flags, sizeof(atlas->Flags), seed);
+    seed = ImHash(&atlas->TexDesiredWidth, sizeof(atlas->TexDesiredWidth), seed);
+    seed = ImHash(&atlas->TexGlyphPadding, sizeof(atlas->TexGlyphPadding), seed);
+    seed = ImHash(&atlas->SDFSpread, sizeof(atlas->SDFSpread), seed);
+    seed = ImHash(&atlas->Fonts.Size, sizeof(atlas->Fonts.Size), seed);
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[input_i];
+        const int dst_font_n = ImFontAtlasCacheFindFont(atlas, cfg.DstFont);
+        int ranges_size = 0;
+        while (cfg.GlyphRanges[ranges_size] && cfg.GlyphRanges[ranges_size + 1])
+            ranges_size += 2;
+        seed = ImHash(cfg.FontData, cfg.FontDataSize, seed);
+        seed = ImHash(&cfg.FontDataSize, sizeof(cfg.FontDataSize), seed);
+        seed = ImHash(&cfg.FontNo, sizeof(cfg.FontNo), seed);
+        seed = ImHash(&cfg.SizePixels, sizeof(cfg.SizePixels), seed);
+        seed = ImHash(&cfg.OversampleH, sizeof(cfg.OversampleH), seed);
+        seed = ImHash(&cfg.OversampleV, sizeof(cfg.OversampleV), seed);
+        seed = ImHash(&cfg.PixelSnapH, sizeof(cfg.PixelSnapH), seed);
+        seed = ImHash(&cfg.GlyphExtraSpacing, sizeof(cfg.GlyphExtraSpacing), seed);
+        seed = ImHash(&cfg.GlyphOffset, sizeof(cfg.GlyphOffset), seed);
+        seed = ImHash(&ranges_size, sizeof(ranges_size), seed);
+        if (ranges_size > 0)
+            seed = ImHash(cfg.GlyphRanges, ranges_size * (int)sizeof(ImWchar), seed);
+        seed = ImHash(&cfg.MergeMode, sizeof(cfg.MergeMode), seed);
+        seed = ImHash(&cfg.RasterizerFlags, sizeof(cfg.RasterizerFlags), seed);
+        seed = ImHash(&cfg.RasterizerMultiply, sizeof(cfg.RasterizerMultiply), seed);
+        seed = ImHash(&cfg.RasterizerScale, sizeof(cfg.RasterizerScale), seed);
+        seed = ImHash(&dst_font_n, sizeof(dst_font_n), seed);
+    }
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlas::CustomRect& r = atlas->CustomRects[i];
+        const int font_n = ImFontAtlasCacheFindFont(atlas, r.Font);
+        seed = ImHash(&r.ID, sizeof(r.ID), seed);
+        seed = ImHash(&r.Width, sizeof(r.Width), seed);
+        seed = ImHash(&r.Height, sizeof(r.Height), seed);
+        seed = ImHash(&r.GlyphAdvanceX, sizeof(r.GlyphAdvanceX), seed);
+        seed = ImHash(&r.GlyphOffset, sizeof(r.GlyphOffset), seed);
+        seed = ImHash(&font_n, sizeof(font_n), seed);
+    }
+    return seed;
+}
+
+// Read one custom rectangle of a cache file, with the index of its font instead of the pointer
+static bool ImFontAtlasCacheReadCustomRect(const unsigned char*& p, const unsigned char* p_end, ImFontAtlas::CustomRect* r, int* out_font_n)
+{
+    if (p_end - p < FONT_ATLAS_CACHE_CUSTOM_RECT_SIZE)
+        return false;
+    ImFontAtlasCacheRead(p, p_end, &r->ID, sizeof(r->ID));
+    ImFontAtlasCacheRead(p, p_end, &r->Width, sizeof(unsigned short));
+    ImFontAtlasCacheRead(p, p_end, &r->Height, sizeof(unsigned short));
+    ImFontAtlasCacheRead(p, p_end, &r->X, sizeof(unsigned short));
+    ImFontAtlasCacheRead(p, p_end, &r->Y, sizeof(unsigned short));
+    ImFontAtlasCacheRead(p, p_end, &r->GlyphAdvanceX, sizeof(float));
+    ImFontAtlasCacheRead(p, p_end, &r->GlyphOffset, 2 * sizeof(float));
+    ImFontAtlasCacheRead(p, p_end, out_font_n, sizeof(int));
+    return true;
+}
+
+// Restore the output of Build() from the contents of a cache file.
+// add_fonts == false: the cache of the fonts in the atlas, fails when it wasn't built from the same inputs. add_fonts == true: a baked atlas, the fonts are created from the file.
+// The atlas is left untouched on failure.
+static bool ImFontAtlasBuildLoadFromMemory(ImFontAtlas* atlas, const unsigned char* data, int data_size, bool add_fonts)
+{
+    // Validate the header and the sizes before modifying anything
+    const unsigned char* p = data;
+    const unsigned char* p_end = data + data_size;
+    char magic[4];
+    ImU32 version = 0, inputs_hash = 0;
+    int flags = 0, sdf_spread = 0, tex_width = 0, tex_height = 0, fonts_count = 0, custom_rects_count = 0;
+    bool ok = ImFontAtlasCacheRead(p, p_end, magic, 4) && memcmp(magic, "ImFA", 4) == 0;
+    ok = ok && ImFontAtlasCacheRead(p, p_end, &version, sizeof(version)) && version == FONT_ATLAS_CACHE_VERSION;
+    ok = ok && ImFontAtlasCacheRead(p, p_end, &inputs_hash, sizeof(inputs_hash)) && (add_fonts || inputs_hash == ImFontAtlasBuildCalcInputsHash(atlas));
+    ok = ok && ImFontAtlasCacheRead(p, p_end, &flags, sizeof(flags)) && ImFontAtlasCacheRead(p, p_end, &sdf_spread, sizeof(sdf_spread));
+    ok = ok && ImFontAtlasCacheRead(p, p_end, &tex_width, sizeof(tex_width)) && ImFontAtlasCacheRead(p, p_end, &tex_height, sizeof(tex_height));
+    ok = ok && ImFontAtlasCacheRead(p, p_end, &fonts_count, sizeof(fonts_count)) && (add_fonts ? fonts_count > 0 : fonts_count == atlas->Fonts.Size);
+    ok = ok && ImFontAtlasCacheRead(p, p_end, &custom_rects_count, sizeof(custom_rects_count)) && (add_fonts ? custom_rects_count > 0 : custom_rects_count == atlas->CustomRects.Size);
+    const unsigned char* p_fonts = p;
+    for (int font_n = 0; ok && font_n < fonts_count; font_n++)
+    {
+        int glyphs_count = 0;
+        ok = (p_end - p) >= FONT_ATLAS_CACHE_FONT_SIZE;
+        if (ok)
+            p += FONT_ATLAS_CACHE_FONT_SIZE;
+        ok = ok && ImFontAtlasCacheRead(p, p_end, &glyphs_count, sizeof(glyphs_count));
+        ok = ok && glyphs_count >= 0 && (p_end - p) / FONT_ATLAS_CACHE_GLYPH_SIZE >= glyphs_count;
+        if (ok)
+            p += glyphs_count * FONT_ATLAS_CACHE_GLYPH_SIZE;
+    }
+    int default_rect_n = -1;
+    for (int i = 0; ok && i < custom_rects_count; i++)
+    {
+        ImFontAtlas::CustomRect r;
+        int font_n = -1;
+        ok = ImFontAtlasCacheReadCustomRect(p, p_end, &r, &font_n) && font_n >= -1 && font_n < fonts_count;
+        if (r.ID == FONT_ATLAS_DEFAULT_TEX_DATA_ID)
+            default_rect_n = i;
+    }
+    ok = ok && default_rect_n >= 0 && tex_width > 0 && tex_height > 0 && (p_end - p) % tex_width == 0 && (p_end - p) / tex_width == tex_height;
+    if (!ok)
+        return false;
+
+    if (add_fonts)
+    {
+        // Baked fonts get a font config without font data, they can't be built again
+        const int restored_flags = ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_SDF;
+        atlas->Flags = (atlas->Flags & ~restored_flags) | (flags & restored_flags);
+        atlas->SDFSpread = sdf_spread;
+        atlas->ConfigData.resize(fonts_count, ImFontConfig());
+        for (int font_n = 0; font_n < fonts_count; font_n++)
+            atlas->Fonts.push_back(IM_NEW(ImFont));
+        atlas->CustomRects.resize(custom_rects_count);
+        atlas->CustomRectIds[0] = default_rect_n;
+    }
+
+    // Fonts
+    p = p_fonts;
+    for (int font_n = 0; font_n < fonts_count; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        font->ClearOutputData();
+        font->ContainerAtlas = atlas;
+        char name[FONT_ATLAS_CACHE_FONT_NAME_SIZE];
+        ImFontAtlasCacheRead(p, p_end, name, FONT_ATLAS_CACHE_FONT_NAME_SIZE);
+        if (add_fonts)
+        {
+            ImFontConfig& cfg = atlas->ConfigData[font_n];
+            cfg.DstFont = font;
+            memcpy(cfg.Name, name, sizeof(cfg.Name));
+            cfg.Name[IM_ARRAYSIZE(cfg.Name) - 1] = 0;
+            font->ConfigData = &cfg;
+            font->ConfigDataCount = 1;
+        }
+        else
+        {
+            for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+                if (atlas->ConfigData[input_i].DstFont == font)
+                {
+                    if (font->ConfigData == NULL)
+                        font->ConfigData = &atlas->ConfigData[input_i];
+                    font->ConfigDataCount++;
+                }
+        }
+        int glyphs_count = 0;
+        ImFontAtlasCacheRead(p, p_end, &font->FontSize, sizeof(float));
+        ImFontAtlasCacheRead(p, p_end, &font->Ascent, sizeof(float));
+        ImFontAtlasCacheRead(p, p_end, &font->Descent, sizeof(float));
+        ImFontAtlasCacheRead(p, p_end, &font->MetricsTotalSurface, sizeof(int));
+        ImVec2 display_offset;
+        ImWchar fallback_char;
+        ImFontAtlasCacheRead(p, p_end, &display_offset, 2 * sizeof(float));
+        ImFontAtlasCacheRead(p, p_end, &fallback_char, sizeof(ImWchar));
+        ImFontAtlasCacheRead(p, p_end, &glyphs_count, sizeof(glyphs_count));
+        if (add_fonts)
+        {
+            // Not part of the glyphs but set after AddFont*() (e.g. DisplayOffset by AddFontDefault()). Fonts restored from the cache keep their own values.
+            font->ConfigData->SizePixels = font->FontSize;
+            font->DisplayOffset = display_offset;
+            font->FallbackChar = fallback_char;
+        }
+        font->Glyphs.resize(glyphs_count);
+        for (int glyph_n = 0; glyph_n < glyphs_count; glyph_n++)
+        {
+            ImFontGlyph& glyph = font->Glyphs[glyph_n];
+            ImFontAtlasCacheRead(p, p_end, &glyph.Codepoint, sizeof(ImWchar));
+            ImFontAtlasCacheRead(p, p_end, &glyph.AdvanceX, 9 * sizeof(float));
+        }
+    }
+
+    // Custom rectangles and texture
+    for (int i = 0; i < custom_rects_count; i++)
+    {
+        ImFontAtlas::CustomRect& r = atlas->CustomRects[i];
+        int font_n = -1;
+        ImFontAtlasCacheReadCustomRect(p, p_end, &r, &font_n);
+        r.Font = (font_n >= 0) ? atlas->Fonts[font_n] : NULL;
+    }
+    atlas->TexID = NULL;
+    atlas->ClearTexData();
+    atlas->TexWidth = tex_width;
+    atlas->TexHeight = tex_height;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    atlas->TexUpdateRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+    atlas->TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc((size_t)(tex_width * tex_height));
+    memcpy(atlas->TexPixelsAlpha8, p, (size_t)(tex_width * tex_height));
+
+    const ImFontAtlas::CustomRect& r = atlas->CustomRects[atlas->CustomRectIds[0]];
+    atlas->TexUvWhitePixel = ImVec2((r.X + 0.5f) * atlas->TexUvScale.x, (r.Y + 0.5f) * atlas->TexUvScale.y);
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+        atlas->Fonts[font_n]->BuildLookupTable();
+    return true;
+}
+
+// Restore the output of a previous Build() from the cache file, if it was built from the same inputs. Returns false if the file is missing or out of date, leaving the atlas untouched.
+bool ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename)
+{
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    IM_ASSERT(atlas->ConfigData.Size > 0);
+    ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+        if (!atlas->ConfigData[input_i].GlyphRanges)
+            atlas->ConfigData[input_i].GlyphRanges = atlas->GetGlyphRangesDefault();
+
+    int file_size = 0;
+    unsigned char* file_data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (file_data == NULL)
+        return false;
+    const bool ret = ImFontAtlasBuildLoadFromMemory(atlas, file_data, file_size, false);
+    ImGui::MemFree(file_data);
+    return ret;
+}
+
+// Write the output of Build() to the cache file. Call right after building, before modifying the texture (e.g. custom rectangles).
+// The file can also be embedded with binary_to_compressed_c.cpp -atlas and loaded with AddFontsFromMemoryCompressedBakedAtlas().
+bool ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename)
+{
+    IM_ASSERT(atlas->TexPixelsAlpha8 != NULL && !(atlas->Flags & ImFontAtlasFlags_DynamicGlyphs));
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    ImVector<unsigned char> buf;
+    int glyphs_total_count = 0;
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+        glyphs_total_count += atlas->Fonts[font_n]->Glyphs.Size;
+    buf.reserve(9 * 4 + atlas->Fonts.Size * (FONT_ATLAS_CACHE_FONT_SIZE + 4) + glyphs_total_count * FONT_ATLAS_CACHE_GLYPH_SIZE + atlas->CustomRects.Size * FONT_ATLAS_CACHE_CUSTOM_RECT_SIZE + atlas->TexWidth * atlas->TexHeight);
+
+    const ImU32 inputs_hash = ImFontAtlasBuildCalcInputsHash(atlas);
+    ImFontAtlasCacheWrite(buf, "ImFA", 4);
+    ImFontAtlasCacheWrite(buf, &FONT_ATLAS_CACHE_VERSION, sizeof(FONT_ATLAS_CACHE_VERSION));
+    ImFontAtlasCacheWrite(buf, &inputs_hash, sizeof(inputs_hash));
+    ImFontAtlasCacheWrite(buf, &atlas->Flags, sizeof(atlas->Flags));
+    ImFontAtlasCacheWrite(buf, &atlas->SDFSpread, sizeof(atlas->SDFSpread));
+    ImFontAtlasCacheWrite(buf, &atlas->TexWidth, sizeof(atlas->TexWidth));
+    ImFontAtlasCacheWrite(buf, &atlas->TexHeight, sizeof(atlas->TexHeight));
+    ImFontAtlasCacheWrite(buf, &atlas->Fonts.Size, sizeof(atlas->Fonts.Size));
+    ImFontAtlasCacheWrite(buf, &atlas->CustomRects.Size, sizeof(atlas->CustomRects.Size));
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        const ImFont* font = atlas->Fonts[font_n];
+        char name[FONT_ATLAS_CACHE_FONT_NAME_SIZE];
+        memset(name, 0, sizeof(name));
+        if (font->ConfigData)
+            ImStrncpy(name, font->ConfigData->Name, IM_ARRAYSIZE(name));
+        ImFontAtlasCacheWrite(buf, name, FONT_ATLAS_CACHE_FONT_NAME_SIZE);
+        ImFontAtlasCacheWrite(buf, &font->FontSize, sizeof(float));
+        ImFontAtlasCacheWrite(buf, &font->Ascent, sizeof(float));
+        ImFontAtlasCacheWrite(buf, &font->Descent, sizeof(float));
+        ImFontAtlasCacheWrite(buf, &font->MetricsTotalSurface, sizeof(int));
+        ImFontAtlasCacheWrite(buf, &font->DisplayOffset, 2 * sizeof(float));
+        ImFontAtlasCacheWrite(buf, &font->FallbackChar, sizeof(ImWchar));
+        ImFontAtlasCacheWrite(buf, &font->Glyphs.Size, sizeof(int));
+        for (int glyph_n = 0; glyph_n < font->Glyphs.Size; glyph_n++)
+        {
+            const ImFontGlyph& glyph = font->Glyphs[glyph_n];
+            ImFontAtlasCacheWrite(buf, &glyph.Codepoint, sizeof(ImWchar));
+            ImFontAtlasCacheWrite(buf, &glyph.AdvanceX, 9 * sizeof(float));
+        }
+    }
+    for (int i = 0; i < atlas->CustomRects.Size; i++)
+    {
+        const ImFontAtlas::CustomRect& r = atlas->CustomRects[i];
+        const int font_n = ImFontAtlasCacheFindFont(atlas, r.Font);
+        ImFontAtlasCacheWrite(buf, &r.ID, sizeof(r.ID));
+        ImFontAtlasCacheWrite(buf, &r.Width, sizeof(unsigned short));
+        ImFontAtlasCacheWrite(buf, &r.Height, sizeof(unsigned short));
+        ImFontAtlasCacheWrite(buf, &r.X, sizeof(unsigned short));
+        ImFontAtlasCacheWrite(buf, &r.Y, sizeof(unsigned short));
+        ImFontAtlasCacheWrite(buf, &r.GlyphAdvanceX, sizeof(float));
+        ImFontAtlasCacheWrite(buf, &r.GlyphOffset, 2 * sizeof(float));
+        ImFontAtlasCacheWrite(buf, &font_n, sizeof(font_n));
+    }
+    ImFontAtlasCacheWrite(buf, atlas->TexPixelsAlpha8, atlas->TexWidth * atlas->TexHeight);
+
+    FILE* f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const bool ok = fwrite(buf.Data, 1, (size_t)buf.Size, f) == (size_t)buf.Size;
+    return (fclose(f) == 0) && ok;
+}
+
+#ifndef IMGUI_DISABLE_STB_TRUETYPE
+
+// Copy pixels written to TexPixelsAlpha8 into TexPixelsRGBA32 if it was already converted, and add them to TexUpdateRect
+static void ImFontAtlasBuildUpdateTexRect(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    if (atlas->TexPixelsRGBA32)
+        for (int py = y; py < y + h; py++)
+            ImFontAtlasBuildExpandAlpha8ToRGBA32(atlas->TexPixelsRGBA32 + py * atlas->TexWidth + x, atlas->TexPixelsAlpha8 + py * atlas->TexWidth + x, w);
+    ImVec4& update_rect = atlas->TexUpdateRect;
+    const ImVec4 rect((float)x, (float)y, (float)(x + w), (float)(y + h));
+    if (update_rect.x >= update_rect.z)
+        update_rect = rect;
+    else
+        update_rect = ImVec4(ImMin(update_rect.x, rect.x), ImMin(update_rect.y, rect.y), ImMax(update_rect.z, rect.z), ImMax(update_rect.w, rect.w));
+}
+
+// Grow the texture of an atlas whose packer was kept alive, with room for twice 'surface' pixels as the packing isn't perfect.
+// Existing pixels stay at the same position, the texture coordinates of glyphs are rescaled. Returns false when the texture can't grow anymore.
+static bool ImFontAtlasBuildGrowTexture(ImFontAtlas* atlas, int surface)
+{
+    // Widen the texture while it is narrower than tall (the new columns are free on the whole height), else add rows
+    ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData;
+    const int max_tex_size = FONT_ATLAS_DYNAMIC_MAX_TEX_SIZE;
+    const int old_width = atlas->TexWidth;
+    const int old_height = atlas->TexHeight;
+    int new_width = old_width, new_height = old_height;
+    while (new_width * new_height - old_width * old_height < surface * 2)
+    {
+        if (new_width < new_height && new_width * 2 <= max_tex_size)
+        {
+            new_width *= 2;
+        }
+        else if (new_height < max_tex_size)
+        {
+            new_height += (surface * 2 - (new_width * new_height - old_width * old_height) + new_width - 1) / new_width;
+            new_height = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? new_height : ImUpperPowerOfTwo(new_height);
+            new_height = ImMin(new_height, max_tex_size);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (new_width == old_width && new_height == old_height)
+        return false;
+
+    // Grow pixels, keeping the existing glyphs at the same position
+    unsigned char* new_pixels_alpha8 = (unsigned char*)ImGui::MemAlloc((size_t)(new_width * new_height));
+    memset(new_pixels_alpha8, 0, (size_t)(new_width * new_height));
+    for (int y = 0; y < old_height; y++)
+        memcpy(new_pixels_alpha8 + y * new_width, atlas->TexPixelsAlpha8 + y * old_width, (size_t)old_width);
+    ImGui::MemFree(atlas->TexPixelsAlpha8);
+    atlas->TexPixelsAlpha8 = new_pixels_alpha8;
+    if (atlas->TexPixelsRGBA32)
+    {
+        unsigned int* new_pixels_rgba32 = (unsigned int*)ImGui::MemAlloc((size_t)(new_width * new_height * 4));
+        for (unsigned int* p = new_pixels_rgba32; p < new_pixels_rgba32 + new_width * new_height; p++)
+            *p = IM_COL32(255, 255, 255, 0);
+        for (int y = 0; y < old_height; y++)
+            memcpy(new_pixels_rgba32 + y * new_width, atlas->TexPixelsRGBA32 + y * old_width, (size_t)(old_width * 4));
+        ImGui::MemFree(atlas->TexPixelsRGBA32);
+        atlas->TexPixelsRGBA32 = new_pixels_rgba32;
+    }
+
+    // Resize the packer. When widening, reallocate the skyline nodes (one per column, as stbtt_PackBegin() does) and append a free segment on the right.
+    stbtt_pack_context& spc = dynamic_data->PackContext;
+    stbrp_context* pack_context = (stbrp_context*)spc.pack_info;
+    if (new_width != old_width)
+    {
+        ImVector<stbrp_node> skyline;
+        for (const stbrp_node* node = pack_context->active_head; node->next != NULL; node = node->next)
+            skyline.push_back(*node);
+        const int old_pack_width = pack_context->width;
+        const int num_nodes = new_width - spc.padding;
+        ImGui::MemFree(spc.nodes);
+        spc.nodes = ImGui::MemAlloc(sizeof(stbrp_node) * (size_t)num_nodes);
+        stbrp_init_target(pack_context, new_width - spc.padding, new_height, (stbrp_node*)spc.nodes, num_nodes);
+        stbrp_node* last = &pack_context->extra[0];
+        last->y = skyline[0].y;
+        for (int n = 1; n <= skyline.Size; n++)
+        {
+            if (n == skyline.Size && last->y == 0)
+                break;
+            stbrp_node* node = pack_context->free_head;
+            pack_context->free_head = node->next;
+            node->x = (n < skyline.Size) ? skyline[n].x : (stbrp_coord)old_pack_width;
+            node->y = (n < skyline.Size) ? skyline[n].y : 0;
+            last->next = node;
+            last = node;
+        }
+        last->next = &pack_context->extra[1];
+    }
+    spc.pixels = atlas->TexPixelsAlpha8;
+    spc.width = spc.stride_in_bytes = new_width;
+    spc.height = new_height;
+    pack_context->height = new_height;
+
+    // Texture coordinates are normalized: recompute them for existing glyphs from their texel, so successive growths don't accumulate rounding errors
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+        for (int glyph_n = 0; glyph_n < atlas->Fonts[font_n]->Glyphs.Size; glyph_n++)
+        {
+            ImFontGlyph& glyph = atlas->Fonts[font_n]->Glyphs[glyph_n];
+            glyph.U0 = (float)(int)(glyph.U0 * old_width + 0.5f) / new_width;
+            glyph.U1 = (float)(int)(glyph.U1 * old_width + 0.5f) / new_width;
+            glyph.V0 = (float)(int)(glyph.V0 * old_height + 0.5f) / new_height;
+            glyph.V1 = (float)(int)(glyph.V1 * old_height + 0.5f) / new_height;
+        }
+    atlas->TexWidth = new_width;
+    atlas->TexHeight = new_height;
+    atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
+    const ImFontAtlas::CustomRect& white_rect = atlas->CustomRects[atlas->CustomRectIds[0]];
+    atlas->TexUvWhitePixel = ImVec2((white_rect.X + 0.5f) * atlas->TexUvScale.x, (white_rect.Y + 0.5f) * atlas->TexUvScale.y);
+    atlas->TexUpdateRect = ImVec4(0.0f, 0.0f, (float)atlas->TexWidth, (float)atlas->TexHeight);    // The texture size changed: the back-end recreates it from all pixels
+    return true;
+}
+
+bool ImFontAtlasBuildDynamicHasFailedGlyphs(const ImFontAtlas* atlas)
+{
+    return atlas->DynamicData && !atlas->DynamicData->PackFailedGlyphs.empty();
+}
+
+// Grow the texture of a dynamic atlas if glyphs didn't fit during the last frame. Called by NewFrame(), before any glyph is used.
+void ImFontAtlasBuildDynamicNewFrame(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData;
+    if (dynamic_data == NULL || dynamic_data->PackFailedGlyphs.empty())
+        return;
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+
+    // Grow the texture so they fit next time, and look the failed glyphs up again.
+    // If the texture can't grow anymore they keep the fallback glyph, else they would be retried and fail again every frame.
+    if (ImFontAtlasBuildGrowTexture(atlas, dynamic_data->PackFailedSurface))
+        for (int n = 0; n < dynamic_data->PackFailedGlyphs.Size; n++)
+        {
+            const ImFontAtlasDynamicFailedGlyph& failed_glyph = dynamic_data->PackFailedGlyphs[n];
+            ImFontIndexPage* page = failed_glyph.Font->AllocIndexPage(failed_glyph.Codepoint);
+            if (page->GlyphIndex[failed_glyph.Codepoint & 0xFF] == (unsigned short)-1)
+                page->AdvanceX[failed_glyph.Codepoint & 0xFF] = -1.0f;
+        }
+    dynamic_data->PackFailedGlyphs.resize(0);
+    dynamic_data->PackFailedSurface = 0;
+}
+
+// Add a font to an atlas whose packer was kept alive by Build(): rasterize its glyphs into the free space of the texture, growing it if needed.
+// The texture keeps its other glyphs and custom rectangles, updated pixels are reported in TexUpdateRect. Called by AddFont().
+bool ImFontAtlasBuildAddFontIncremental(ImFontAtlas* atlas, ImFontConfig* font_config)
+{
+    ImFontAtlasDynamicData* dynamic_data = atlas->DynamicData;
+    IM_ASSERT(dynamic_data != NULL && font_config == &atlas->ConfigData.back() && dynamic_data->FontInfo.Size == atlas->ConfigData.Size - 1);
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    ImFontConfig& cfg = *font_config;
+    ImFont* dst_font = cfg.DstFont;
+    IM_ASSERT(!cfg.MergeMode || dst_font->ConfigData + dst_font->ConfigDataCount == font_config); // Can only merge into the last font, as the sources of a font are contiguous in ConfigData[]
+
+    const int font_offset = stbtt_GetFontOffsetForIndex((unsigned char*)cfg.FontData, cfg.FontNo);
+    IM_ASSERT(font_offset >= 0);
+    stbtt_fontinfo font_info;
+    if (!stbtt_InitFont(&font_info, (unsigned char*)cfg.FontData, font_offset))
+        return false;
+    dynamic_data->FontInfo.push_back(font_info);
+
+    // Select the ranges to rasterize now (see ImFontAtlasBuildWithStbTruetype())
+    if (!cfg.GlyphRanges)
+        cfg.GlyphRanges = atlas->GetGlyphRangesDefault();
+    const ImWchar dynamic_glyphs_prebuilt_max = (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) ? 0xFF : 0xFFFF;
+    ImVector<stbtt_pack_range> ranges;
+    int glyphs_count = 0;
+    for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1]; in_range += 2)
+        if (in_range[0] <= dynamic_glyphs_prebuilt_max)
+        {
+            stbtt_pack_range range;
+            memset(&range, 0, sizeof(range));
+            range.font_size = cfg.SizePixels * cfg.RasterizerScale;
+            range.first_unicode_codepoint_in_range = in_range[0];
+            range.num_chars = (ImMin(in_range[1], dynamic_glyphs_prebuilt_max) - in_range[0]) + 1;
+            ranges.push_back(range);
+            glyphs_count += range.num_chars;
+        }
+    ImVector<stbtt_packedchar> packed_chars;
+    ImVector<stbrp_rect> rects;
+    packed_chars.resize(glyphs_count);
+    rects.resize(glyphs_count);
+    memset(packed_chars.Data, 0, (size_t)glyphs_count * sizeof(stbtt_packedchar));
+    memset(rects.Data, 0, (size_t)glyphs_count * sizeof(stbrp_rect));
+    for (int i = 0, n = 0; i < ranges.Size; n += ranges[i].num_chars, i++)
+        ranges[i].chardata_for_range = packed_chars.Data + n;
+
+    // Pack into the free space, then grow the texture for the glyphs which didn't fit
+    stbtt_pack_context& spc = dynamic_data->PackContext;
+    ImFontAtlasBuildGatherRects(atlas, cfg, &spc, &font_info, ranges.Data, ranges.Size, rects.Data);
+    for (int n = 0; n < rects.Size; n++)
+        rects[n].id = n;
+    stbrp_pack_rects((stbrp_context*)spc.pack_info, rects.Data, rects.Size);
+    ImVector<stbrp_rect> failed_rects;
+    for (;;)
+    {
+        int failed_surface = 0;
+        failed_rects.resize(0);
+        for (int n = 0; n < rects.Size; n++)
+            if (!rects[n].was_packed)
+            {
+                failed_rects.push_back(rects[n]);
+                failed_surface = ImMin(failed_surface + rects[n].w * rects[n].h, FONT_ATLAS_DYNAMIC_MAX_SURFACE);
+            }
+        if (failed_rects.empty())
+            break;
+        if (!ImFontAtlasBuildGrowTexture(atlas, failed_surface))
+            return false;   // The font doesn't fit anymore: AddFont() invalidates the texture, the next Build() packs all fonts again
+        stbrp_pack_rects((stbrp_context*)spc.pack_info, failed_rects.Data, failed_rects.Size);
+        for (int n = 0; n < failed_rects.Size; n++)
+            rects[failed_rects[n].id] = failed_rects[n];
+    }
+
+    // Rasterize, then register glyphs
+    int x0 = atlas->TexWidth, y0 = atlas->TexHeight, x1 = 0, y1 = 0;
+    for (int n = 0; n < rects.Size; n++)
+        if (rects[n].was_packed)
+        {
+            x0 = ImMin(x0, (int)rects[n].x);
+            y0 = ImMin(y0, (int)rects[n].y);
+            x1 = ImMax(x1, (int)(rects[n].x + rects[n].w));
+            y1 = ImMax(y1, (int)(rects[n].y + rects[n].h));
+        }
+    ImFontAtlasBuildRenderRects(atlas, cfg, &spc, &font_info, ranges.Data, ranges.Size, rects.Data);
+    if (x0 < x1)
+        ImFontAtlasBuildUpdateTexRect(atlas, x0, y0, x1 - x0, y1 - y0);
+    ImFontAtlasBuildSetupFontGlyphs(atlas, cfg, &font_info, ranges.Data, ranges.Size);
+    dst_font->BuildLookupTable();
+    return true;
+}
+
+#else
+
+// Without a font builder there are no dynamic glyphs nor incremental fonts
+bool ImFontAtlasBuildDynamicHasFailedGlyphs(const ImFontAtlas*)             { return false; }
+void ImFontAtlasBuildDynamicNewFrame(ImFontAtlas*)                          { }
+bool ImFontAtlasBuildAddFontIncremental(ImFontAtlas*, ImFontConfig*)        { return false; }
+
+#endif // #ifndef IMGUI_DISABLE_STB_TRUETYPE
+
 // Retrieve list of range (2 int per range, values are inclusive)
 const ImWchar*   ImFontAtlas::GetGlyphRangesDefault()
 {
@@ -2015,6 +3376,17 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesChinese()
     return &ranges[0];
 }
 
+// Write base_ranges[] followed by one single code point range per entry of accumulative_offsets[] (successive offsets from base_codepoint, each with an implicit +1) and a zero terminator
+static const ImWchar* UnpackAccumulativeOffsetsIntoRanges(const ImWchar* base_ranges, int base_ranges_count, int base_codepoint, const short* accumulative_offsets, int accumulative_offsets_count, ImWchar* out_ranges)
+{
+    memcpy(out_ranges, base_ranges, base_ranges_count * sizeof(ImWchar));
+    ImWchar* dst = out_ranges + base_ranges_count;
+    for (int n = 0; n < accumulative_offsets_count; n++, dst += 2)
+        dst[0] = dst[1] = (ImWchar)(base_codepoint += (accumulative_offsets[n] + 1));
+    dst[0] = 0;
+    return out_ranges;
+}
+
 const ImWchar*  ImFontAtlas::GetGlyphRangesJapanese()
 {
     // Store the 1946 ideograms code points as successive offsets from the initial unicode codepoint 0x4E00. Each offset has an implicit +1.
@@ -2057,27 +3429,17 @@ const ImWchar*  ImFontAtlas::GetGlyphRangesJapanese()
         19,3,8,0,0,0,4,4,16,0,4,1,5,1,3,0,3,4,6,2,17,10,10,31,6,4,3,6,10,126,7,3,2,2,0,9,0,0,5,20,13,0,15,0,6,0,2,5,8,64,50,3,2,12,2,9,0,0,11,8,20,
         109,2,18,23,0,0,9,61,3,0,28,41,77,27,19,17,81,5,2,14,5,83,57,252,14,154,263,14,20,8,13,6,57,39,38,
     };
-    static ImWchar base_ranges[] =
+    static const ImWchar base_ranges[] =
     {
         0x0020, 0x00FF, // Basic Latin + Latin Supplement
         0x3000, 0x30FF, // Punctuations, Hiragana, Katakana
         0x31F0, 0x31FF, // Katakana Phonetic Extensions
         0xFF00, 0xFFEF, // Half-width characters
     };
-    static bool full_ranges_unpacked = false;
+    // Unpack on first use. The initialization of a function-local static only runs once even when called from several threads.
     static ImWchar full_ranges[IM_ARRAYSIZE(base_ranges) + IM_ARRAYSIZE(offsets_from_0x4E00)*2 + 1];
-    if (!full_ranges_unpacked)
-    {
-        // Unpack
-        int codepoint = 0x4e00;
-        memcpy(full_ranges, base_ranges, sizeof(base_ranges));
-        ImWchar* dst = full_ranges + IM_ARRAYSIZE(base_ranges);
-        for (int n = 0; n < IM_ARRAYSIZE(offsets_from_0x4E00); n++, dst += 2)
-            dst[0] = dst[1] = (ImWchar)(codepoint += (offsets_from_0x4E00[n] + 1));
-        dst[0] = 0;
-        full_ranges_unpacked = true;
-    }
-    return &full_ranges[0];
+    static const ImWchar* full_ranges_unpacked = UnpackAccumulativeOffsetsIntoRanges(base_ranges, IM_ARRAYSIZE(base_ranges), 0x4E00, offsets_from_0x4E00, IM_ARRAYSIZE(offsets_from_0x4E00), full_ranges);
+    return full_ranges_unpacked;
 }
 
 const ImWchar*  ImFontAtlas::GetGlyphRangesCyrillic()
@@ -2147,11 +3509,24 @@ void ImFontAtlas::GlyphRangesBuilder::BuildRanges(ImVector<ImWchar>* out_ranges)
 // ImFont
 //-----------------------------------------------------------------------------
 
+// Page shared by the blocks of 256 code points without glyphs. Its negative AdvanceX sends lookups to LoadGlyphAdvanceX(), which returns FallbackAdvanceX.
+#define IM_REPEAT_4(_X)     _X, _X, _X, _X
+#define IM_REPEAT_16(_X)    IM_REPEAT_4(_X), IM_REPEAT_4(_X), IM_REPEAT_4(_X), IM_REPEAT_4(_X)
+#define IM_REPEAT_64(_X)    IM_REPEAT_16(_X), IM_REPEAT_16(_X), IM_REPEAT_16(_X), IM_REPEAT_16(_X)
+#define IM_REPEAT_256(_X)   IM_REPEAT_64(_X), IM_REPEAT_64(_X), IM_REPEAT_64(_X), IM_REPEAT_64(_X)
+static const ImFontIndexPage FontIndexEmptyPage = { { IM_REPEAT_256(-1.0f) }, { IM_REPEAT_256(0xFFFF) } };
+#undef IM_REPEAT_4
+#undef IM_REPEAT_16
+#undef IM_REPEAT_64
+#undef IM_REPEAT_256
+
 ImFont::ImFont()
 {
     Scale = 1.0f;
     FallbackChar = (ImWchar)'?';
     DisplayOffset = ImVec2(0.0f, 0.0f);
+    for (int n = 0; n < IM_ARRAYSIZE(IndexPages); n++)
+        IndexPages[n] = &FontIndexEmptyPage;
     ClearOutputData();
 }
 
@@ -2172,8 +3547,12 @@ void    ImFont::ClearOutputData()
 {
     FontSize = 0.0f;
     Glyphs.clear();
-    IndexAdvanceX.clear();
-    IndexLookup.clear();
+    for (int n = 0; n < IM_ARRAYSIZE(IndexPages); n++)
+    {
+        if (IndexPages[n] != &FontIndexEmptyPage)
+            ImGui::MemFree(const_cast<ImFontIndexPage*>(IndexPages[n]));
+        IndexPages[n] = &FontIndexEmptyPage;
+    }
     FallbackGlyph = NULL;
     FallbackAdvanceX = 0.0f;
     ConfigDataCount = 0;
@@ -2186,20 +3565,20 @@ void    ImFont::ClearOutputData()
 
 void ImFont::BuildLookupTable()
 {
-    int max_codepoint = 0;
-    for (int i = 0; i != Glyphs.Size; i++)
-        max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
+    // With ImFontAtlasFlags_DynamicGlyphs, code points which haven't been looked up yet keep a negative AdvanceX, see LoadGlyph()
+    const bool dynamic_glyphs = ContainerAtlas && ContainerAtlas->DynamicData && (ContainerAtlas->Flags & ImFontAtlasFlags_DynamicGlyphs);
 
     IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
-    IndexAdvanceX.clear();
-    IndexLookup.clear();
+    for (int n = 0; n < IM_ARRAYSIZE(IndexPages); n++)
+        if (IndexPages[n] != &FontIndexEmptyPage)
+            memcpy(const_cast<ImFontIndexPage*>(IndexPages[n]), &FontIndexEmptyPage, sizeof(ImFontIndexPage));
     DirtyLookupTables = false;
-    GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
-        int codepoint = (int)Glyphs[i].Codepoint;
-        IndexAdvanceX[codepoint] = Glyphs[i].AdvanceX;
-        IndexLookup[codepoint] = (unsigned short)i;
+        const ImWchar codepoint = Glyphs[i].Codepoint;
+        ImFontIndexPage* page = AllocIndexPage(codepoint);
+        page->AdvanceX[codepoint & 0xFF] = Glyphs[i].AdvanceX;
+        page->GlyphIndex[codepoint & 0xFF] = (unsigned short)i;
     }
 
     // Create a glyph to handle TAB
@@ -2212,15 +3591,23 @@ void ImFont::BuildLookupTable()
         tab_glyph = *FindGlyph((unsigned short)' ');
         tab_glyph.Codepoint = '\t';
         tab_glyph.AdvanceX *= 4;
-        IndexAdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
-        IndexLookup[(int)tab_glyph.Codepoint] = (unsigned short)(Glyphs.Size-1);
+        ImFontIndexPage* page = AllocIndexPage(tab_glyph.Codepoint);
+        page->AdvanceX[(int)tab_glyph.Codepoint] = (float)tab_glyph.AdvanceX;
+        page->GlyphIndex[(int)tab_glyph.Codepoint] = (unsigned short)(Glyphs.Size-1);
     }
 
+    // Code points of the empty page get FallbackAdvanceX from LoadGlyphAdvanceX(), fill the other pages to avoid the call
     FallbackGlyph = FindGlyphNoFallback(FallbackChar);
     FallbackAdvanceX = FallbackGlyph ? FallbackGlyph->AdvanceX : 0.0f;
-    for (int i = 0; i < max_codepoint + 1; i++)
-        if (IndexAdvanceX[i] < 0.0f)
-            IndexAdvanceX[i] = FallbackAdvanceX;
+    if (!dynamic_glyphs)
+        for (int n = 0; n < IM_ARRAYSIZE(IndexPages); n++)
+            if (IndexPages[n] != &FontIndexEmptyPage)
+            {
+                ImFontIndexPage* page = const_cast<ImFontIndexPage*>(IndexPages[n]);
+                for (int i = 0; i < IM_ARRAYSIZE(page->AdvanceX); i++)
+                    if (page->AdvanceX[i] < 0.0f)
+                        page->AdvanceX[i] = FallbackAdvanceX;
+            }
 }
 
 void ImFont::SetFallbackChar(ImWchar c)
@@ -2229,13 +3616,16 @@ void ImFont::SetFallbackChar(ImWchar c)
     BuildLookupTable();
 }
 
-void ImFont::GrowIndex(int new_size)
+ImFontIndexPage* ImFont::AllocIndexPage(ImWchar c)
 {
-    IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
-    if (new_size <= IndexLookup.Size)
-        return;
-    IndexAdvanceX.resize(new_size, -1.0f);
-    IndexLookup.resize(new_size, (unsigned short)-1);
+    const ImFontIndexPage*& page = IndexPages[c >> 8];
+    if (page == &FontIndexEmptyPage)
+    {
+        ImFontIndexPage* new_page = (ImFontIndexPage*)ImGui::MemAlloc(sizeof(ImFontIndexPage));
+        memcpy(new_page, &FontIndexEmptyPage, sizeof(ImFontIndexPage));
+        page = new_page;
+    }
+    return const_cast<ImFontIndexPage*>(page);
 }
 
 void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
@@ -2263,39 +3653,122 @@ void ImFont::AddGlyph(ImWchar codepoint, float x0, float y0, float x1, float y1,
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
-    IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
-    int index_size = IndexLookup.Size;
+    IM_ASSERT(IsLoaded() && !DirtyLookupTables);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
+    const ImFontIndexPage* dst_page = IndexPages[dst >> 8];
+    const ImFontIndexPage* src_page = IndexPages[src >> 8];
 
-    if (dst < index_size && IndexLookup.Data[dst] == (unsigned short)-1 && !overwrite_dst) // 'dst' already exists
+    if (dst_page != &FontIndexEmptyPage && dst_page->GlyphIndex[dst & 0xFF] == (unsigned short)-1 && !overwrite_dst) // 'dst' already exists
         return;
-    if (src >= index_size && dst >= index_size) // both 'dst' and 'src' don't exist -> no-op
+    if (src_page == &FontIndexEmptyPage && dst_page == &FontIndexEmptyPage) // both 'dst' and 'src' don't exist -> no-op
         return;
 
-    GrowIndex(dst + 1);
-    IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (unsigned short)-1;
-    IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    ImFontIndexPage* page = AllocIndexPage(dst);
+    page->GlyphIndex[dst & 0xFF] = src_page->GlyphIndex[src & 0xFF];
+    page->AdvanceX[dst & 0xFF] = (src_page != &FontIndexEmptyPage) ? src_page->AdvanceX[src & 0xFF] : 1.0f;
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= IndexLookup.Size)
-        return FallbackGlyph;
-    const unsigned short i = IndexLookup[c];
+    const ImFontIndexPage* page = IndexPages[c >> 8];
+    const unsigned short i = page->GlyphIndex[c & 0xFF];
     if (i == (unsigned short)-1)
+    {
+        if (page->AdvanceX[c & 0xFF] < 0.0f)
+            if (const ImFontGlyph* glyph = const_cast<ImFont*>(this)->LoadGlyph(c))
+                return glyph;
         return FallbackGlyph;
+    }
     return &Glyphs.Data[i];
 }
 
 const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
 {
-    if (c >= IndexLookup.Size)
-        return NULL;
-    const unsigned short i = IndexLookup[c];
+    const unsigned short i = IndexPages[c >> 8]->GlyphIndex[c & 0xFF];
     if (i == (unsigned short)-1)
         return NULL;
     return &Glyphs.Data[i];
 }
 
+// Rasterize a glyph on first use with ImFontAtlasFlags_DynamicGlyphs, using the first font source which has it (same order as ImFontAtlasBuildWithStbTruetype() for merged fonts).
+// The texture pixels are updated right away and reported in ContainerAtlas->TexUpdateRect, the back-end uploads them before rendering.
+const ImFontGlyph* ImFont::LoadGlyph(ImWchar c)
+{
+    ImFontAtlas* atlas = ContainerAtlas;
+    ImFontAtlasDynamicData* dynamic_data = atlas ? atlas->DynamicData : NULL;
+    if (dynamic_data == NULL || !(atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) || ConfigDataCount == 0)
+        return NULL;
+#ifndef IMGUI_DISABLE_STB_TRUETYPE
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
+    ImFontIndexPage* page = AllocIndexPage(c);
+    page->AdvanceX[c & 0xFF] = FallbackAdvanceX;    // Look this code point up only once
+    if (Glyphs.Size >= 0xFFFE)
+        return NULL;
+
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[input_i];
+        if (cfg.DstFont != this)
+            continue;
+        bool in_ranges = false;
+        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1] && !in_ranges; in_range += 2)
+            in_ranges = (c >= in_range[0] && c <= in_range[1]);
+        const stbtt_fontinfo* font_info = &dynamic_data->FontInfo[input_i];
+        if (!in_ranges || stbtt_FindGlyphIndex(font_info, c) == 0)
+            continue;
+
+        // Pack
+        stbtt_pack_context& spc = dynamic_data->PackContext;
+        stbtt_packedchar packed_char;
+        stbtt_pack_range range;
+        stbrp_rect rect;
+        memset(&packed_char, 0, sizeof(packed_char));
+        memset(&range, 0, sizeof(range));
+        memset(&rect, 0, sizeof(rect));
+        range.font_size = cfg.SizePixels * cfg.RasterizerScale;
+        range.first_unicode_codepoint_in_range = c;
+        range.num_chars = 1;
+        range.chardata_for_range = &packed_char;
+        ImFontAtlasBuildGatherRects(atlas, cfg, &spc, font_info, &range, 1, &rect);
+        stbrp_pack_rects((stbrp_context*)spc.pack_info, &rect, 1);
+        if (!rect.was_packed)
+        {
+            // No space left: use the fallback glyph until NewFrame() grows the texture
+            ImFontAtlasDynamicFailedGlyph failed_glyph = { this, c };
+            dynamic_data->PackFailedGlyphs.push_back(failed_glyph);
+            dynamic_data->PackFailedSurface = ImMin(dynamic_data->PackFailedSurface + rect.w * rect.h, FONT_ATLAS_DYNAMIC_MAX_SURFACE);
+            return NULL;
+        }
+
+        // Rasterize
+        ImFontAtlasBuildRenderRects(atlas, cfg, &spc, font_info, &range, 1, &rect);
+        ImFontAtlasBuildUpdateTexRect(atlas, rect.x, rect.y, rect.w, rect.h);
+
+        // Register glyph
+        stbtt_aligned_quad q;
+        float dummy_x = 0.0f, dummy_y = 0.0f;
+        stbtt_GetPackedQuad(&packed_char, atlas->TexWidth, atlas->TexHeight, 0, &dummy_x, &dummy_y, &q, 0);
+        const float off_x = cfg.GlyphOffset.x;
+        const float off_y = cfg.GlyphOffset.y + (float)(int)(Ascent + 0.5f);
+        const float rasterizer_scale_inv = 1.0f / cfg.RasterizerScale;
+        AddGlyph(c, q.x0 * rasterizer_scale_inv + off_x, q.y0 * rasterizer_scale_inv + off_y, q.x1 * rasterizer_scale_inv + off_x, q.y1 * rasterizer_scale_inv + off_y, q.s0, q.t0, q.s1, q.t1, packed_char.xadvance * rasterizer_scale_inv);
+        DirtyLookupTables = false;
+        page->AdvanceX[c & 0xFF] = Glyphs.back().AdvanceX;
+        page->GlyphIndex[c & 0xFF] = (unsigned short)(Glyphs.Size - 1);
+        FallbackGlyph = FindGlyphNoFallback(FallbackChar);  // Glyphs[] may have been reallocated
+        return &Glyphs.back();
+    }
+#else
+    (void)c;
+#endif
+    return NULL;
+}
+
+float ImFont::LoadGlyphAdvanceX(ImWchar c)
+{
+    const ImFontGlyph* glyph = LoadGlyph(c);
+    return glyph ? glyph->AdvanceX : FallbackAdvanceX;
+}
+
 const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const char* text_end, float wrap_width) const
 {
     // Simple word-wrapping for English, not full-featured. Please submit failing cases!
@@ -2316,6 +3789,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
     float line_width = 0.0f;
     float word_width = 0.0f;
     float blank_width = 0.0f;
+    const ImFontIndexPage* latin_page = IndexPages[0];  // Fast path for code points 0..255
     wrap_width /= scale; // We work with unscaled widths to avoid scaling every characters
 
     const char* word_end = text;
@@ -2350,7 +3824,9 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
             }
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX[(int)c] : FallbackAdvanceX);
+        float char_width = (c < 0x100) ? latin_page->AdvanceX[c] : (c < 0x10000) ? IndexPages[c >> 8]->AdvanceX[c & 0xFF] : FallbackAdvanceX;
+        if (char_width < 0.0f)
+            char_width = const_cast<ImFont*>(this)->LoadGlyphAdvanceX((ImWchar)c);
         if (ImCharIsSpace(c))
         {
             if (inside_word)
@@ -2402,6 +3878,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
 
     const float line_height = size;
     const float scale = size / FontSize;
+    const ImFontIndexPage* latin_page = IndexPages[0];  // Fast path for code points 0..255
 
     ImVec2 text_size = ImVec2(0,0);
     float line_width = 0.0f;
@@ -2467,7 +3944,10 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 continue;
         }
 
-        const float char_width = ((int)c < IndexAdvanceX.Size ? IndexAdvanceX[(int)c] : FallbackAdvanceX) * scale;
+        float char_width = (c < 0x100) ? latin_page->AdvanceX[c] : (c < 0x10000) ? IndexPages[c >> 8]->AdvanceX[c & 0xFF] : FallbackAdvanceX;
+        if (char_width < 0.0f)
+            char_width = const_cast<ImFont*>(this)->LoadGlyphAdvanceX((ImWchar)c);
+        char_width *= scale;
         if (line_width + char_width >= max_width)
         {
             s = prev_s;
@@ -2651,10 +4131,10 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
                     {
                         idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
                         idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
-                        vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                        vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                        vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                        vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                        vtx_write[0].pos = ImVec2(x1, y1); vtx_write[0].col = col; vtx_write[0].uv = ImVec2(u1, v1);
+                        vtx_write[1].pos = ImVec2(x2, y1); vtx_write[1].col = col; vtx_write[1].uv = ImVec2(u2, v1);
+                        vtx_write[2].pos = ImVec2(x2, y2); vtx_write[2].col = col; vtx_write[2].uv = ImVec2(u2, v2);
+                        vtx_write[3].pos = ImVec2(x1, y2); vtx_write[3].col = col; vtx_write[3].uv = ImVec2(u1, v2);
                         vtx_write += 4;
                         vtx_current_idx += 4;
                         idx_write += 6;
@@ -2760,8 +4240,8 @@ static unsigned int stb_decompress_length(unsigned char *input)
     return (input[8] << 24) + (input[9] << 16) + (input[10] << 8) + input[11];
 }
 
-static unsigned char *stb__barrier, *stb__barrier2, *stb__barrier3, *stb__barrier4;
-static unsigned char *stb__dout;
+static IM_THREAD_LOCAL unsigned char *stb__barrier, *stb__barrier2, *stb__barrier3, *stb__barrier4;
+static IM_THREAD_LOCAL unsigned char *stb__dout;
 static void stb__match(unsigned char *data, unsigned int length)
 {
     // INVERSE of memmove... write each byte before copying the next...
@@ -16,6 +16,12 @@
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
 
+// Enable SSE2 intrinsics when the compiler targets them (always the case on x86-64)
+#if (defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_ENABLE_SSE
+#include <emmintrin.h>  // __m128i, _mm_unpacklo_epi8, ...
+#endif
+
 #ifdef _MSC_VER
 #pragma warning (push)
 #pragma warning (disable: 4251) // class 'xxx' needs to have dll-interface to be used by clients of struct 'xxx' // when IMGUI_API is set to__declspec(dllexport)
@@ -72,10 +78,26 @@ namespace ImGuiStb
 // Context
 //-----------------------------------------------------------------------------
 
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+#define IM_THREAD_LOCAL     thread_local    // Per-thread global state, see IMGUI_USE_THREAD_LOCAL_CONTEXT in imconfig.h
+#else
+#define IM_THREAD_LOCAL
+#endif
+
 #ifndef GImGui
-extern IMGUI_API ImGuiContext* GImGui;  // Current implicit ImGui context pointer
+extern IMGUI_API IM_THREAD_LOCAL ImGuiContext* GImGui;  // Current implicit ImGui context pointer
 #endif
 
+extern IMGUI_API IM_THREAD_LOCAL ImGuiMemOwner GImAllocatorOwner;   // Owner given to new allocations, see ImGuiMemStats
+
+// Helper: tag the allocations made during the lifetime of this object with the given owner (restore the previous owner on destruction)
+struct ImGuiMemOwnerScope
+{
+    ImGuiMemOwner   BackupOwner;
+    ImGuiMemOwnerScope(ImGuiMemOwner owner) { BackupOwner = GImAllocatorOwner; GImAllocatorOwner = owner; }
+    ~ImGuiMemOwnerScope()                   { GImAllocatorOwner = BackupOwner; }
+};
+
 //-----------------------------------------------------------------------------
 // Helpers
 //-----------------------------------------------------------------------------
@@ -295,6 +317,15 @@ enum ImGuiNavForward
     ImGuiNavForward_ForwardActive
 };
 
+enum ImGuiInputEventType
+{
+    ImGuiInputEventType_MousePos,
+    ImGuiInputEventType_MouseButton,
+    ImGuiInputEventType_MouseWheel,
+    ImGuiInputEventType_Key,
+    ImGuiInputEventType_KeyMods
+};
+
 // 2D axis aligned bounding-box
 // NB: we can't rely on ImVec2 math operators being available here
 struct IMGUI_API ImRect
@@ -423,6 +454,18 @@ struct ImGuiSettingsHandler
     ImGuiSettingsHandler() { memset(this, 0, sizeof(*this)); }
 };
 
+// Input event queued by io.AddMouseButtonEvent() etc., applied by NewFrame()
+struct ImGuiInputEvent
+{
+    ImGuiInputEventType Type;
+    double              Time;       // Timestamp given by the back-end, in seconds (< 0.0: unknown)
+    int                 Index;      // MouseButton: button index, Key: index into io.KeysDown[], KeyMods: 1 << 0..3 for Ctrl, Shift, Alt, Super
+    bool                Down;       // MouseButton, Key
+    ImVec2              Value;      // MousePos: position, MouseWheel: horizontal and vertical amount
+
+    ImGuiInputEvent(ImGuiInputEventType type, double time) { Type = type; Time = time; Index = 0; Down = false; Value = ImVec2(0.0f, 0.0f); }
+};
+
 // Storage for current popup stack
 struct ImGuiPopupRef
 {
@@ -476,6 +519,37 @@ struct ImGuiColumnsSet
     }
 };
 
+// Key of a tessellated shape in ImDrawListShapeCache (no padding, hashed as raw bytes)
+struct ImDrawListShapeKey
+{
+    ImVec2          Size;
+    float           Rounding;
+    float           Thickness;                  // 0.0f for filled shapes
+    int             Flags;                      // ImDrawCornerFlags_ | (ImDrawListFlags_ << 4)
+};
+
+// Tessellated shape, stored relative to its upper-left corner. Ranges point into the ImDrawListShapeCache buffers.
+struct ImDrawListCachedShape
+{
+    ImDrawListShapeKey Key;
+    int             VtxOffset, VtxCount;
+    int             IdxOffset, IdxCount;
+};
+
+// Tessellation cache of a draw list for rounded rectangles, which are rebuilt every frame with the same sizes for frames, buttons, window borders (see AddRect(), AddRectFilled()).
+// Shapes are translated and recolored on emit. The cache is flushed when reaching ImDrawListSharedData::ShapeCacheMaxCount entries.
+// Owned by each ImDrawList, so draw lists sharing the same ImDrawListSharedData can still be filled from different threads.
+struct ImDrawListShapeCache
+{
+    ImVector<ImDrawListCachedShape> Shapes;
+    ImGuiStorage                    Map;                    // Hash of ImDrawListShapeKey -> index in Shapes + 1
+    ImVector<ImVec2>                VtxPos;                 // Vertex positions relative to the shape upper-left corner
+    ImVector<unsigned char>         VtxOpaque;              // 1: vertex uses the shape color, 0: vertex uses the transparent color (anti-aliased fringe)
+    ImVector<ImDrawIdx>             Idx;                    // Indices relative to the first vertex of the shape
+
+    void            Clear()                     { Shapes.resize(0); Map.Clear(); VtxPos.resize(0); VtxOpaque.resize(0); Idx.resize(0); }
+};
+
 struct IMGUI_API ImDrawListSharedData
 {
     ImVec2          TexUvWhitePixel;            // UV of white pixel in the atlas
@@ -488,6 +562,8 @@ struct IMGUI_API ImDrawListSharedData
     // FIXME: Bake rounded corners fill/borders in atlas
     ImVec2          CircleVtx12[12];
 
+    int             ShapeCacheMaxCount;         // = 512, size of the tessellation cache of each draw list (see ImDrawListShapeCache), 0 to disable it
+
     ImDrawListSharedData();
 };
 
@@ -500,6 +576,14 @@ struct ImDrawDataBuilder
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
+// Draw list of the previous frame, to compute ImDrawData::DamageRects (io.OptDamageRects)
+struct ImGuiDrawListDamageInfo
+{
+    const ImDrawList*   DrawList;
+    ImU32               Hash;       // Hash of vertices, indices and commands
+    ImRect              Bounds;     // Pixels which may be touched by the draw list (vertices bounding box clipped by the commands clipping rectangles)
+};
+
 struct ImGuiNavMoveResult
 {
     ImGuiID       ID;           // Best candidate
@@ -600,6 +684,11 @@ struct ImGuiContext
     bool                    NextTreeNodeOpenVal;                // Storage for SetNextTreeNode** functions
     ImGuiCond               NextTreeNodeOpenCond;
 
+    // Input event queue
+    ImVector<ImGuiInputEvent> InputEventsQueue;                 // Events not applied yet, see io.AddMouseButtonEvent() etc.
+    double                  InputEventsMouseDownTime[5];        // Timestamp of the mouse button press applied this frame (< 0.0: none, or not timestamped)
+    double                  InputEventsMouseClickedTime[5];     // Timestamp of the last click, to detect double-clicks with the back-end clock (< 0.0: unknown)
+
     // Navigation data (for gamepad/keyboard)
     ImGuiWindow*            NavWindow;                          // Focused window for navigation. Could be called 'FocusWindow'
     ImGuiID                 NavId;                              // Focused item for navigation
@@ -640,6 +729,11 @@ struct ImGuiContext
     ImDrawDataBuilder       DrawDataBuilder;
     float                   ModalWindowDarkeningRatio;
     ImDrawList              OverlayDrawList;                    // Optional software render of mouse cursors, if io.MouseDrawCursor is set + a few debug overlays
+    ImVector<ImDrawList*>   MergedDrawLists;                    // Output of the merging pass when io.OptMergeDrawLists is set (owned by the context, reused every frame)
+    ImVector<ImGuiDrawListDamageInfo> DamageDrawLists;          // Draw lists of the previous frame, in render order (io.OptDamageRects)
+    ImVector<ImGuiDrawListDamageInfo> DamageDrawListsTemp;
+    ImVec2                  DamageDisplaySize;                  // io.DisplaySize of the previous frame
+    ImVector<ImVec4>        DamageRects;                        // Output for ImDrawData::DamageRects
     ImGuiMouseCursor        MouseCursor;
 
     // Drag and Drop
@@ -685,6 +779,15 @@ struct ImGuiContext
     int                     LogStartDepth;
     int                     LogAutoExpandMaxDepth;
 
+    // Profiler (io.OptProfiler)
+    ImGuiProfilerFrame      ProfilerFrames[120];                // Ring buffer of recorded frames
+    int                     ProfilerFramesHead;                 // Index of the frame being recorded
+    int                     ProfilerFramesCount;                // Number of complete frames in ProfilerFrames[]
+    bool                    ProfilerFrameActive;                // A frame is being recorded (started by NewFrame(), or by a zone pushed outside of a frame)
+    bool                    ProfilerFrameHasNewFrame;           // NewFrame() has been called for the frame being recorded
+    double                  ProfilerFrameStartTime;
+    ImVector<int>           ProfilerZoneStack;                  // Index of open zones in ProfilerFrames[ProfilerFramesHead].Zones
+
     // Misc
     float                   FramerateSecPerFrame[120];          // calculate estimate of framerate for user
     int                     FramerateSecPerFrameIdx;
@@ -692,6 +795,7 @@ struct ImGuiContext
     int                     WantCaptureMouseNextFrame;          // explicit capture via CaptureInputs() sets those flags
     int                     WantCaptureKeyboardNextFrame;
     int                     WantTextInputNextFrame;
+    float                   RequestFrameDelay;                  // Smallest delay passed to RequestFrame() during the frame (FLT_MAX: none)
     char                    TempBuffer[1024*3+1];               // temporary text buffer
 
     ImGuiContext(ImFontAtlas* shared_font_atlas) : OverlayDrawList(NULL)
@@ -754,6 +858,7 @@ struct ImGuiContext
         ModalWindowDarkeningRatio = 0.0f;
         OverlayDrawList._Data = &DrawListSharedData;
         OverlayDrawList._OwnerName = "##Overlay"; // Give it a name for debugging
+        DamageDisplaySize = ImVec2(-1.0f, -1.0f);
         MouseCursor = ImGuiMouseCursor_Arrow;
 
         DragDropActive = false;
@@ -785,10 +890,17 @@ struct ImGuiContext
         LogStartDepth = 0;
         LogAutoExpandMaxDepth = 2;
 
+        ProfilerFramesHead = ProfilerFramesCount = 0;
+        ProfilerFrameActive = ProfilerFrameHasNewFrame = false;
+        ProfilerFrameStartTime = 0.0;
+
         memset(FramerateSecPerFrame, 0, sizeof(FramerateSecPerFrame));
         FramerateSecPerFrameIdx = 0;
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
+        RequestFrameDelay = FLT_MAX;
+        for (int n = 0; n < IM_ARRAYSIZE(InputEventsMouseDownTime); n++)
+            InputEventsMouseDownTime[n] = InputEventsMouseClickedTime[n] = -1.0;
         memset(TempBuffer, 0, sizeof(TempBuffer));
     }
 };
@@ -1017,6 +1129,14 @@ namespace ImGui
     IMGUI_API void          Initialize(ImGuiContext* context);
     IMGUI_API void          Shutdown(ImGuiContext* context);    // Since 1.60 this is a _private_ function. You can call DestroyContext() to destroy the context created by CreateContext().
 
+    // Profiler (io.OptProfiler). Calls must be balanced. The name must stay valid for the lifetime of the context (static string, window name).
+    IMGUI_API void          ProfilerPushZone(const char* name);
+    IMGUI_API void          ProfilerPopZone();
+
+    // Allocate/free from worker threads: call the allocator functions directly, without the block header and statistics of MemAlloc(). The allocator functions need to be thread-safe (the default ones are).
+    IMGUI_API void*         MemAllocThreadSafe(size_t size);
+    IMGUI_API void          MemFreeThreadSafe(void* ptr);
+
     IMGUI_API void                  MarkIniSettingsDirty();
     IMGUI_API ImGuiSettingsHandler* FindSettingsHandler(const char* type_name);
     IMGUI_API ImGuiWindowSettings*  FindWindowSettings(ImGuiID id);
@@ -1131,8 +1251,14 @@ IMGUI_API void              ImFontAtlasBuildRegisterDefaultCustomRects(ImFontAtl
 IMGUI_API void              ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent); 
 IMGUI_API void              ImFontAtlasBuildPackCustomRects(ImFontAtlas* atlas, void* spc);
 IMGUI_API void              ImFontAtlasBuildFinish(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasBuildLoadCache(ImFontAtlas* atlas, const char* filename);
+IMGUI_API bool              ImFontAtlasBuildSaveCache(ImFontAtlas* atlas, const char* filename);
+IMGUI_API bool              ImFontAtlasBuildDynamicHasFailedGlyphs(const ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasBuildDynamicNewFrame(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasBuildAddFontIncremental(ImFontAtlas* atlas, ImFontConfig* font_config);
 IMGUI_API void              ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void              ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API void              ImFontAtlasBuildExpandAlpha8ToRGBA32(unsigned int* dst, const unsigned char* src, int count);
 
 #ifdef __clang__
 #pragma clang diagnostic pop
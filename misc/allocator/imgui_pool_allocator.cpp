@@ -0,0 +1,154 @@
+// Size-class pool allocator for Dear ImGui, to use with ImGui::SetAllocatorFunctions()
+// See README.md for usage.
+
+#include "imgui_pool_allocator.h"
+#include <stdlib.h>     // malloc, free
+#include <string.h>     // memcpy
+
+// Header stored in front of every block. Its size keeps 16 bytes alignment on 64-bit targets (size classes are multiples of 16 bytes).
+struct ImGuiPoolBlockHeader
+{
+    size_t      SizeClass;      // Index into FreeLists[], or LargeBlock
+    size_t      Capacity;       // Usable bytes after the header
+};
+
+static const size_t LargeBlock = (size_t)-1;
+
+ImGuiPoolAllocator::ImGuiPoolAllocator()
+{
+    for (int n = 0; n < SizeClassCount; n++)
+        FreeLists[n] = NULL;
+    Pages = NULL;
+    SystemAllocCount = 0;
+    SystemAllocBytes = 0;
+}
+
+ImGuiPoolAllocator::~ImGuiPoolAllocator()
+{
+    ReleaseMemory();
+}
+
+void ImGuiPoolAllocator::ReleaseMemory()
+{
+    // Unpaged classes are made of individual blocks
+    for (int n = 0; n < SizeClassCount; n++)
+    {
+        if (((size_t)SizeClassMin << n) > SizeClassPagedMax)
+        {
+            for (void* block = FreeLists[n]; block != NULL; )
+            {
+                void* next = *(void**)block;
+                ImGuiPoolBlockHeader* header = (ImGuiPoolBlockHeader*)block - 1;
+                SystemAllocBytes -= sizeof(ImGuiPoolBlockHeader) + header->Capacity;
+                free(header);
+                block = next;
+            }
+        }
+        FreeLists[n] = NULL;
+    }
+    while (Pages != NULL)
+    {
+        void* next = *(void**)Pages;
+        free(Pages);
+        SystemAllocBytes -= PageSize;
+        Pages = next;
+    }
+}
+
+void* ImGuiPoolAllocator::Alloc(size_t size)
+{
+    int class_n = 0;
+    size_t class_size = SizeClassMin;
+    while (class_size < size && class_n < SizeClassCount)
+    {
+        class_size <<= 1;
+        class_n++;
+    }
+
+    // Large blocks
+    if (class_n == SizeClassCount)
+    {
+        ImGuiPoolBlockHeader* header = (ImGuiPoolBlockHeader*)malloc(sizeof(ImGuiPoolBlockHeader) + size);
+        if (header == NULL)
+            return NULL;
+        header->SizeClass = LargeBlock;
+        header->Capacity = size;
+        SystemAllocCount++;
+        SystemAllocBytes += sizeof(ImGuiPoolBlockHeader) + size;
+        return header + 1;
+    }
+
+    // Refill free list
+    if (FreeLists[class_n] == NULL)
+    {
+        const size_t block_stride = sizeof(ImGuiPoolBlockHeader) + class_size;
+        if (class_size <= SizeClassPagedMax)
+        {
+            // Carve a new page. The first bytes of the page link to the previous page, we reserve a full header to keep blocks aligned.
+            char* page = (char*)malloc(PageSize);
+            if (page == NULL)
+                return NULL;
+            *(void**)page = Pages;
+            Pages = page;
+            SystemAllocCount++;
+            SystemAllocBytes += PageSize;
+            for (char* p = page + sizeof(ImGuiPoolBlockHeader); p + block_stride <= page + PageSize; p += block_stride)
+            {
+                ImGuiPoolBlockHeader* header = (ImGuiPoolBlockHeader*)p;
+                header->SizeClass = (size_t)class_n;
+                header->Capacity = class_size;
+                *(void**)(header + 1) = FreeLists[class_n];
+                FreeLists[class_n] = header + 1;
+            }
+        }
+        else
+        {
+            ImGuiPoolBlockHeader* header = (ImGuiPoolBlockHeader*)malloc(block_stride);
+            if (header == NULL)
+                return NULL;
+            header->SizeClass = (size_t)class_n;
+            header->Capacity = class_size;
+            *(void**)(header + 1) = NULL;
+            FreeLists[class_n] = header + 1;
+            SystemAllocCount++;
+            SystemAllocBytes += block_stride;
+        }
+    }
+
+    void* block = FreeLists[class_n];
+    FreeLists[class_n] = *(void**)block;
+    return block;
+}
+
+void ImGuiPoolAllocator::Free(void* ptr)
+{
+    if (ptr == NULL)
+        return;
+    ImGuiPoolBlockHeader* header = (ImGuiPoolBlockHeader*)ptr - 1;
+    if (header->SizeClass == LargeBlock)
+    {
+        SystemAllocBytes -= sizeof(ImGuiPoolBlockHeader) + header->Capacity;
+        free(header);
+        return;
+    }
+    *(void**)ptr = FreeLists[header->SizeClass];
+    FreeLists[header->SizeClass] = ptr;
+}
+
+void* ImGuiPoolAllocator::Realloc(void* ptr, size_t old_size, size_t new_size)
+{
+    if (ptr != NULL && new_size <= ((ImGuiPoolBlockHeader*)ptr - 1)->Capacity)
+        return ptr;
+    void* new_ptr = Alloc(new_size);
+    if (ptr != NULL)
+    {
+        memcpy(new_ptr, ptr, old_size);
+        Free(ptr);
+    }
+    return new_ptr;
+}
+
+void ImGuiPoolAllocator::SetAsImGuiAllocator()
+{
+    ImGui::SetAllocatorFunctions(AllocFunc, FreeFunc, this, ReallocFunc);
+}
@@ -0,0 +1,40 @@
+// Size-class pool allocator for Dear ImGui, to use with ImGui::SetAllocatorFunctions()
+// See README.md for usage.
+
+#pragma once
+
+#include "imgui.h"      // IMGUI_API, ImGui::SetAllocatorFunctions
+
+// Blocks are rounded up to a power-of-two size class (16 bytes to 32 KB) and recycled through one free list per class.
+// Classes up to 4 KB are carved from 64 KB pages. Larger blocks go straight to malloc()/free().
+// Memory is only given back to the system by ReleaseMemory() or the destructor, so after a few frames ImGui code stops calling malloc()/free().
+// Blocks can grow in place up to the capacity of their size class (ImVector<> growth goes through the realloc function).
+// NOT thread-safe. Keep the instance alive until every ImGui allocation has been freed (after DestroyContext() and the destruction of your own ImVector<> instances).
+struct IMGUI_API ImGuiPoolAllocator
+{
+    enum
+    {
+        SizeClassCount      = 12,           // 16, 32, 64, ..., 32768 bytes
+        SizeClassMin        = 16,
+        SizeClassPagedMax   = 4096,         // Classes above this size are allocated one block at a time
+        PageSize            = 64 * 1024
+    };
+
+    void*       FreeLists[SizeClassCount];  // Free blocks, linked through their first bytes
+    void*       Pages;                      // Pages, linked through their first bytes
+    int         SystemAllocCount;           // Number of malloc() calls made so far (pages, unpaged classes and large blocks)
+    size_t      SystemAllocBytes;           // Bytes currently obtained from malloc()
+
+    ImGuiPoolAllocator();
+    ~ImGuiPoolAllocator();
+    void        ReleaseMemory();            // Give pages and cached blocks back to the system. Every block must have been freed.
+    void*       Alloc(size_t size);
+    void        Free(void* ptr);
+    void*       Realloc(void* ptr, size_t old_size, size_t new_size);
+    void        SetAsImGuiAllocator();      // Call ImGui::SetAllocatorFunctions() with this instance
+
+    // Functions to pass to ImGui::SetAllocatorFunctions() with user_data = the ImGuiPoolAllocator instance
+    static void* AllocFunc(size_t size, void* user_data)                                { return ((ImGuiPoolAllocator*)user_data)->Alloc(size); }
+    static void  FreeFunc(void* ptr, void* user_data)                                   { ((ImGuiPoolAllocator*)user_data)->Free(ptr); }
+    static void* ReallocFunc(void* ptr, size_t old_size, size_t new_size, void* user_data) { return ((ImGuiPoolAllocator*)user_data)->Realloc(ptr, old_size, new_size); }
+};
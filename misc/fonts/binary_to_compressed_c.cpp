@@ -6,6 +6,8 @@
 // (If we used 32-bits constants it would require take 11 bytes of source code to encode 4 bytes, and be endianness dependent)
 // Note that even with compression, the output array is likely to be bigger than the binary file..
 // Load compressed TTF fonts with ImGui::GetIO().Fonts->AddFontFromMemoryCompressedTTF()
+// With -atlas, the input is a baked font atlas: the cache file written by ImFontAtlas::Build() when ImFontAtlas::CacheFilename is set.
+// Load it with ImGui::GetIO().Fonts->AddFontsFromMemoryCompressedBakedAtlas(), which restores the fonts and texture without parsing or rasterizing any TTF data.
 
 // Build with, e.g:
 //   # cl.exe binary_to_compressed_c.cpp
@@ -13,10 +15,11 @@
 // You can also find a precompiled Windows binary in the binary/demo package available from https://github.com/ocornut/imgui
 
 // Usage:
-//   binary_to_compressed_c.exe [-base85] [-nocompress] <inputfile> <symbolname>
+//   binary_to_compressed_c.exe [-base85] [-nocompress] [-atlas] <inputfile> <symbolname>
 // Usage example:
 //   # binary_to_compressed_c.exe myfont.ttf MyFont > myfont.cpp
 //   # binary_to_compressed_c.exe -base85 myfont.ttf MyFont > myfont.cpp
+//   # binary_to_compressed_c.exe -atlas myfonts_atlas.bin MyFonts > myfonts.cpp
 
 #define _CRT_SECURE_NO_WARNINGS
 #include <stdio.h>
@@ -29,31 +32,43 @@ typedef unsigned int stb_uint;
 typedef unsigned char stb_uchar;
 stb_uint stb_compress(stb_uchar *out,stb_uchar *in,stb_uint len);
 
-static bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_compression);
+static bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_compression, bool is_atlas);
 
 int main(int argc, char** argv)
 {
     if (argc < 3)
     {
-        printf("Syntax: %s [-base85] [-nocompress] <inputfile> <symbolname>\n", argv[0]);
+        printf("Syntax: %s [-base85] [-nocompress] [-atlas] <inputfile> <symbolname>\n", argv[0]);
         return 0;
     }
 
     int argn = 1;
     bool use_base85_encoding = false;
     bool use_compression = true;
-    if (argv[argn][0] == '-')
+    bool is_atlas = false;
+    while (argn < argc - 2 && argv[argn][0] == '-')
     {
         if (strcmp(argv[argn], "-base85") == 0) { use_base85_encoding = true; argn++; }
         else if (strcmp(argv[argn], "-nocompress") == 0) { use_compression = false; argn++; }
+        else if (strcmp(argv[argn], "-atlas") == 0) { is_atlas = true; argn++; }
         else
         {
             printf("Unknown argument: '%s'\n", argv[argn]);
             return 1;
         }
     }
+    if (argn + 1 >= argc)
+    {
+        printf("Missing <inputfile> or <symbolname>\n");
+        return 1;
+    }
+    if (is_atlas && use_base85_encoding && !use_compression)
+    {
+        printf("-atlas -base85 requires compression\n");
+        return 1;
+    }
 
-    return binary_to_compressed_c(argv[argn], argv[argn+1], use_base85_encoding, use_compression) ? 0 : 1;
+    return binary_to_compressed_c(argv[argn], argv[argn+1], use_base85_encoding, use_compression, is_atlas) ? 0 : 1;
 }
 
 char Encode85Byte(unsigned int x) 
@@ -62,7 +77,7 @@ char Encode85Byte(unsigned int x)
     return (x>='\\') ? x+1 : x;
 }
 
-bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_compression)
+bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_base85_encoding, bool use_compression, bool is_atlas)
 {
     // Read file
     FILE* f = fopen(filename, "rb");
@@ -74,6 +89,19 @@ bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_b
     memset((void *)(((char*)data) + data_sz), 0, 4);
     fclose(f);
 
+    // Baked atlas header: "ImFA", version, inputs hash, flags, SDF spread, texture width and height, fonts count (see ImFontAtlasBuildSaveCache() in imgui_draw.cpp)
+    int atlas_header[8];
+    if (is_atlas)
+    {
+        if (data_sz < 4 + (int)sizeof(atlas_header) || memcmp(data, "ImFA", 4) != 0)
+        {
+            fprintf(stderr, "'%s' is not a font atlas cache file\n", filename);
+            delete[] data;
+            return false;
+        }
+        memcpy(atlas_header, data + 4, sizeof(atlas_header));
+    }
+
     // Compress
     int maxlen = data_sz + 512 + (data_sz >> 2) + sizeof(int); // total guess
     char* compressed = use_compression ? new char[maxlen] : data;
@@ -85,6 +113,16 @@ bool binary_to_compressed_c(const char* filename, const char* symbol, bool use_b
     FILE* out = stdout;
     fprintf(out, "// File: '%s' (%d bytes)\n", filename, (int)data_sz);
     fprintf(out, "// Exported using binary_to_compressed_c.cpp\n");
+    if (is_atlas)
+    {
+        fprintf(out, "// Baked font atlas: %d fonts, %dx%d texture\n", atlas_header[6], atlas_header[4], atlas_header[5]);
+        if (use_base85_encoding)
+            fprintf(out, "// Load with io.Fonts->AddFontsFromMemoryCompressedBase85BakedAtlas(%s_compressed_data_base85)\n", symbol);
+        else if (use_compression)
+            fprintf(out, "// Load with io.Fonts->AddFontsFromMemoryCompressedBakedAtlas(%s_compressed_data, %s_compressed_size)\n", symbol, symbol);
+        else
+            fprintf(out, "// Load with io.Fonts->AddFontsFromMemoryBakedAtlas(%s_data, %s_size)\n", symbol, symbol);
+    }
 	const char* compressed_str = use_compression ? "compressed_" : "";
     if (use_base85_encoding)
     {
@@ -9,6 +9,8 @@
 // - v0.53: (2017/10/22) minor inconsequential change to match change in master (removed an unnecessary statement)
 // - v0.54: (2018/01/22) fix for addition of ImFontAtlas::TexUvscale member
 // - v0.55: (2018/02/04) moved to main imgui repository (away from http://www.github.com/ocornut/imgui_club)
+// - v0.56: (2018/03/20) support for ImFontAtlasFlags_SDF (FreeType 2.11+) and ImFontConfig::RasterizerScale.
+// - v0.57: (2018/03/23) glyphs rendered before packing (exact texture height), in parallel with ImFontAtlas::ParallelForFn, and optionally kept in a GlyphCache across builds.
 
 // Gamma Correct Blending:
 //  FreeType assumes blending in linear space rather than gamma space.
@@ -17,7 +19,6 @@
 //  The default imgui styles will be impacted by this change (alpha values will need tweaking).
 
 // TODO:
-// - Output texture has excessive resolution (lots of vertical waste).
 // - FreeType's memory allocator is not overridden.
 // - cfg.OversampleH, OversampleV are ignored (but perhaps not so necessary with this rasterizer).
 
@@ -28,6 +29,12 @@
 #include FT_FREETYPE_H
 #include FT_GLYPH_H
 #include FT_SYNTHESIS_H
+#include FT_MODULE_H
+
+// FT_RENDER_MODE_SDF was added in FreeType 2.11
+#if FREETYPE_MAJOR > 2 || (FREETYPE_MAJOR == 2 && FREETYPE_MINOR >= 11)
+#define IMGUI_FREETYPE_HAS_SDF
+#endif
 
 #ifdef _MSC_VER
 #pragma warning (disable: 4505) // unreferenced local function has been removed (stb stuff)
@@ -95,12 +102,11 @@ namespace
     // NB: No ctor/dtor, explicitly call Init()/Shutdown()
     struct FreeTypeFont
     {
-        bool        Init(const ImFontConfig& cfg, unsigned int extra_user_flags);   // Initialize from an external data buffer. Doesn't copy data, and you must ensure it stays valid up to this object lifetime.
+        bool        Init(const ImFontConfig& cfg, unsigned int extra_user_flags, int sdf_spread);   // Initialize from an external data buffer. Doesn't copy data, and you must ensure it stays valid up to this object lifetime. sdf_spread > 0: render signed distance fields.
         void        Shutdown();
         void        SetPixelHeight(int pixel_height);                               // Change font pixel size. All following calls to RasterizeGlyph() will use this size
 
         bool        CalcGlyphInfo(uint32_t codepoint, GlyphInfo& glyph_info, FT_Glyph& ft_glyph, FT_BitmapGlyph& ft_bitmap);
-        void        BlitGlyph(FT_BitmapGlyph ft_bitmap, uint8_t* dst, uint32_t dst_pitch, unsigned char* multiply_table = NULL);
 
         // [Internals]
         FontInfo        Info;               // Font descriptor of the current font.
@@ -108,14 +114,17 @@ namespace
         FT_Library      FreetypeLibrary;
         FT_Face         FreetypeFace;
         FT_Int32        FreetypeLoadFlags;
+        FT_Render_Mode  FreetypeRenderMode;
     };
 
     // From SDL_ttf: Handy routines for converting from fixed point
     #define FT_CEIL(X)  (((X + 63) & -64) / 64)
 
-    bool FreeTypeFont::Init(const ImFontConfig& cfg, unsigned int extra_user_flags)
+    bool FreeTypeFont::Init(const ImFontConfig& cfg, unsigned int extra_user_flags, int sdf_spread)
     {
         // FIXME: substitute allocator
+        FreetypeLibrary = NULL;
+        FreetypeFace = NULL;
         FT_Error error = FT_Init_FreeType(&FreetypeLibrary);
         if (error != 0)
             return false;
@@ -127,7 +136,7 @@ namespace
             return false;
 
         memset(&Info, 0, sizeof(Info));
-        SetPixelHeight((uint32_t)cfg.SizePixels);
+        SetPixelHeight((uint32_t)(cfg.SizePixels * cfg.RasterizerScale));
 
         // Convert to freetype flags (nb: Bold and Oblique are processed separately)
         UserFlags = cfg.RasterizerFlags | extra_user_flags;
@@ -142,6 +151,20 @@ namespace
         else                                                
             FreetypeLoadFlags |= FT_LOAD_TARGET_NORMAL;
 
+        FreetypeRenderMode = FT_RENDER_MODE_NORMAL;
+#ifdef IMGUI_FREETYPE_HAS_SDF
+        if (sdf_spread > 0)
+        {
+            // Both the outline ("sdf") and the bitmap ("bsdf") renderers, FreeType picks one per glyph
+            FT_Int spread = (FT_Int)sdf_spread;
+            FT_Property_Set(FreetypeLibrary, "sdf", "spread", &spread);
+            FT_Property_Set(FreetypeLibrary, "bsdf", "spread", &spread);
+            FreetypeRenderMode = FT_RENDER_MODE_SDF;
+        }
+#else
+        IM_ASSERT(sdf_spread == 0 && "ImFontAtlasFlags_SDF requires FreeType 2.11 or later");
+#endif
+
         return true;
     }
 
@@ -151,6 +174,9 @@ namespace
         {
             FT_Done_Face(FreetypeFace);
             FreetypeFace = NULL;
+        }
+        if (FreetypeLibrary)
+        {
             FT_Done_FreeType(FreetypeLibrary);
             FreetypeLibrary = NULL;
         }
@@ -200,10 +226,13 @@ namespace
         if (error != 0)
             return false;
 
-        // Rasterize
-        error = FT_Glyph_To_Bitmap(&ft_glyph, FT_RENDER_MODE_NORMAL, NULL, true);
+        // Rasterize (the SDF renderers fail on empty outlines, e.g. spaces)
+        error = FT_Glyph_To_Bitmap(&ft_glyph, (slot->outline.n_points > 0) ? FreetypeRenderMode : FT_RENDER_MODE_NORMAL, NULL, true);
         if (error != 0)
+        {
+            FT_Done_Glyph(ft_glyph);
             return false;
+        }
 
         ft_bitmap = (FT_BitmapGlyph)ft_glyph;
         glyph_info.AdvanceX = (float)FT_CEIL(slot->advance.x);
@@ -215,15 +244,8 @@ namespace
         return true;
     }
 
-    void FreeTypeFont::BlitGlyph(FT_BitmapGlyph ft_bitmap, uint8_t* dst, uint32_t dst_pitch, unsigned char* multiply_table)
+    void BlitGlyph(const uint8_t* src, uint32_t src_pitch, uint32_t w, uint32_t h, uint8_t* dst, uint32_t dst_pitch, const unsigned char* multiply_table = NULL)
     {
-        IM_ASSERT(ft_bitmap != NULL);
-
-        const uint32_t w = ft_bitmap->bitmap.width;
-        const uint32_t h = ft_bitmap->bitmap.rows;
-        const uint8_t* src = ft_bitmap->bitmap.buffer;
-        const uint32_t src_pitch = ft_bitmap->bitmap.pitch;
-
         if (multiply_table == NULL)
         {
             for (uint32_t y = 0; y < h; y++, src += src_pitch, dst += dst_pitch)
@@ -236,6 +258,98 @@ namespace
                     dst[x] = multiply_table[src[x]];
         }
     }
+
+    // A rendered glyph of a GlyphCacheFont.
+    struct CachedGlyph
+    {
+        GlyphInfo   Info;
+        int         PixelsOffset;       // Offset of the Info.Width * Info.Height bitmap in GlyphCacheFont::Pixels. -1: FreeType failed to render the glyph.
+    };
+
+    // Rendered glyphs of a font at a given size and flags. RasterizerMultiply is applied when copying to the atlas, so it is not part of the key.
+    struct GlyphCacheFont
+    {
+        ImU32                   FontDataHash;   // Key: font data contents, not its address which changes when the font file is reloaded
+        int                     FontDataSize;
+        int                     FontNo;
+        int                     PixelHeight;
+        unsigned int            UserFlags;
+        int                     SDFSpread;
+        FontInfo                Info;
+        int                     LastUsedBuild;
+        ImVector<int>           GlyphsIndex;    // Codepoint -> index in Glyphs. -1: not rendered yet.
+        ImVector<CachedGlyph>   Glyphs;
+        ImVector<unsigned char> Pixels;
+
+        bool    Matches(const GlyphCacheFont& other) const { return FontDataHash == other.FontDataHash && FontDataSize == other.FontDataSize && FontNo == other.FontNo && PixelHeight == other.PixelHeight && UserFlags == other.UserFlags && SDFSpread == other.SDFSpread; }
+    };
+
+    // Glyphs rendered by a task of BuildFontAtlas(). Tasks may run on any thread, so each one uses its own FT_Library and FT_Face (FreeType objects are not thread-safe),
+    // and allocates with MemAllocThreadSafe(). The bitmaps are moved to the cache by the main thread.
+    struct RasterTaskGlyph
+    {
+        uint32_t        Codepoint;
+        GlyphInfo       Info;
+        unsigned char*  Pixels;             // NULL: FreeType failed to render the glyph
+    };
+    struct RasterTask
+    {
+        const ImFontConfig* Config;
+        GlyphCacheFont*     CacheFont;
+        int                 GlyphsStart;    // Index in RasterTasks::Glyphs
+        int                 GlyphsCount;
+    };
+    struct RasterTasks
+    {
+        unsigned int                ExtraFlags;
+        int                         SDFSpread;
+        ImVector<RasterTask>        Tasks;
+        ImVector<RasterTaskGlyph>   Glyphs;
+    };
+
+    void RasterTaskFn(void* task_data, int task_n)
+    {
+        RasterTasks* tasks = (RasterTasks*)task_data;
+        const RasterTask& task = tasks->Tasks[task_n];
+        FreeTypeFont font_face;
+        const bool font_ok = font_face.Init(*task.Config, tasks->ExtraFlags, tasks->SDFSpread);
+        for (int n = 0; n < task.GlyphsCount; n++)
+        {
+            RasterTaskGlyph& glyph = tasks->Glyphs[task.GlyphsStart + n];
+            glyph.Pixels = NULL;
+            FT_Glyph ft_glyph = NULL;
+            FT_BitmapGlyph ft_glyph_bitmap = NULL; // NB: will point to bitmap within FT_Glyph
+            if (!font_ok || !font_face.CalcGlyphInfo(glyph.Codepoint, glyph.Info, ft_glyph, ft_glyph_bitmap))
+                continue;
+            const uint32_t w = ft_glyph_bitmap->bitmap.width, h = ft_glyph_bitmap->bitmap.rows;
+            glyph.Pixels = (unsigned char*)ImGui::MemAllocThreadSafe((size_t)ImMax((int)(w * h), 1));
+            BlitGlyph(ft_glyph_bitmap->bitmap.buffer, ft_glyph_bitmap->bitmap.pitch, w, h, glyph.Pixels, w);
+            FT_Done_Glyph(ft_glyph);
+        }
+        font_face.Shutdown();
+    }
+}
+
+struct ImGuiFreeType::GlyphCache
+{
+    ImVector<GlyphCacheFont*>   Fonts;
+    int                         BuildCount;
+    int                         MaxUnusedBuilds;
+};
+
+ImGuiFreeType::GlyphCache* ImGuiFreeType::CreateGlyphCache(int max_unused_builds)
+{
+    GlyphCache* cache = IM_NEW(GlyphCache)();
+    cache->BuildCount = 0;
+    cache->MaxUnusedBuilds = max_unused_builds;
+    return cache;
+}
+
+void ImGuiFreeType::DestroyGlyphCache(GlyphCache* cache)
+{
+    for (int n = 0; n < cache->Fonts.Size; n++)
+        IM_DELETE(cache->Fonts[n]);
+    IM_DELETE(cache);
 }
 
 #define STBRP_ASSERT(x)    IM_ASSERT(x)
@@ -243,10 +357,13 @@ namespace
 #define STB_RECT_PACK_IMPLEMENTATION
 #include "stb_rect_pack.h"
 
-bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags)
+bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags, GlyphCache* cache)
 {
+    ImGuiMemOwnerScope mem_owner(ImGuiMemOwner_FontAtlas);
     IM_ASSERT(atlas->ConfigData.Size > 0);
     IM_ASSERT(atlas->TexGlyphPadding == 1); // Not supported
+    IM_ASSERT(!(atlas->Flags & ImFontAtlasFlags_SDF) || (atlas->SDFSpread >= 2 && atlas->SDFSpread <= 32)); // Range of the FreeType "spread" property
+    ImGui::ProfilerPushZone("FontAtlasBuild");
 
     ImFontAtlasBuildRegisterDefaultCustomRects(atlas);
 
@@ -256,44 +373,184 @@ bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags)
     atlas->TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     atlas->ClearTexData();
 
+    // Without a cache from the user, rendered glyphs only live during this build
+    GlyphCache* temp_cache = (cache == NULL) ? CreateGlyphCache(0) : NULL;
+    if (temp_cache)
+        cache = temp_cache;
+    cache->BuildCount++;
+
     ImVector<FreeTypeFont> fonts;
     fonts.resize(atlas->ConfigData.Size);
-
-    ImVec2 max_glyph_size(1.0f, 1.0f);
-
-    // Count glyphs/ranges, initialize font
-    int total_glyphs_count = 0;
-    int total_ranges_count = 0;
-    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++) 
+    memset(fonts.Data, 0, sizeof(FreeTypeFont) * fonts.Size);
+    ImVector<GlyphCacheFont*> cache_fonts;
+    cache_fonts.resize(atlas->ConfigData.Size);
+    const int sdf_spread = (atlas->Flags & ImFontAtlasFlags_SDF) ? atlas->SDFSpread : 0;
+
+    // Initialize fonts (for their metrics), find their rendered glyphs in the cache
+    bool fonts_ok = true;
+    for (int input_i = 0; input_i < atlas->ConfigData.Size && fonts_ok; input_i++) 
     {
         ImFontConfig& cfg = atlas->ConfigData[input_i];
         FreeTypeFont& font_face = fonts[input_i];
         IM_ASSERT(cfg.DstFont && (!cfg.DstFont->IsLoaded() || cfg.DstFont->ContainerAtlas == atlas));
+        if (!font_face.Init(cfg, extra_flags, sdf_spread))
+        {
+            fonts_ok = false;
+            break;
+        }
+        if (!cfg.GlyphRanges)
+            cfg.GlyphRanges = atlas->GetGlyphRangesDefault();
 
-        if (!font_face.Init(cfg, extra_flags))
-            return false;
+        GlyphCacheFont key;
+        key.FontDataHash = ImHash(cfg.FontData, cfg.FontDataSize, 0);
+        key.FontDataSize = cfg.FontDataSize;
+        key.FontNo = cfg.FontNo;
+        key.PixelHeight = (int)font_face.Info.PixelHeight;
+        key.UserFlags = font_face.UserFlags;
+        key.SDFSpread = sdf_spread;
+        GlyphCacheFont* cache_font = NULL;
+        for (int n = 0; n < cache->Fonts.Size && cache_font == NULL; n++)
+            if (cache->Fonts[n]->Matches(key))
+                cache_font = cache->Fonts[n];
+        if (cache_font == NULL)
+        {
+            cache_font = IM_NEW(GlyphCacheFont)();
+            cache_font->FontDataHash = key.FontDataHash;
+            cache_font->FontDataSize = key.FontDataSize;
+            cache_font->FontNo = key.FontNo;
+            cache_font->PixelHeight = key.PixelHeight;
+            cache_font->UserFlags = key.UserFlags;
+            cache_font->SDFSpread = key.SDFSpread;
+            cache->Fonts.push_back(cache_font);
+        }
+        cache_font->Info = font_face.Info;
+        cache_font->LastUsedBuild = cache->BuildCount;
+        cache_fonts[input_i] = cache_font;
+    }
+    if (!fonts_ok)
+    {
+        for (int n = 0; n < fonts.Size; n++)
+            fonts[n].Shutdown();
+        if (temp_cache)
+            DestroyGlyphCache(temp_cache);
+        ImGui::ProfilerPopZone();
+        return false;
+    }
 
-        max_glyph_size.x = ImMax(max_glyph_size.x, font_face.Info.MaxAdvanceWidth);
-        max_glyph_size.y = ImMax(max_glyph_size.y, font_face.Info.Ascender - font_face.Info.Descender);
+    // Render the glyphs missing from the cache, split in tasks of up to 'glyphs_per_task' glyphs of a same font, which may run in parallel (see ImFontAtlas::ParallelForFn)
+    const int glyphs_per_task = 64;
+    RasterTasks tasks;
+    tasks.ExtraFlags = extra_flags;
+    tasks.SDFSpread = sdf_spread;
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        GlyphCacheFont* cache_font = cache_fonts[input_i];
+        int task_i = -1;
+        for (const ImWchar* in_range = atlas->ConfigData[input_i].GlyphRanges; in_range[0] && in_range[1]; in_range += 2) 
+        {
+            if (cache_font->GlyphsIndex.Size <= (int)in_range[1])
+                cache_font->GlyphsIndex.resize(in_range[1] + 1, -1);
+            for (uint32_t codepoint = in_range[0]; codepoint <= in_range[1]; ++codepoint) 
+            {
+                if (cache_font->GlyphsIndex[codepoint] != -1)
+                    continue;
+                cache_font->GlyphsIndex[codepoint] = -2; // Pending: fonts may share a GlyphCacheFont, or have overlapping ranges
+                if (task_i == -1 || tasks.Tasks[task_i].GlyphsCount == glyphs_per_task)
+                {
+                    RasterTask task = { &atlas->ConfigData[input_i], cache_font, tasks.Glyphs.Size, 0 };
+                    task_i = tasks.Tasks.Size;
+                    tasks.Tasks.push_back(task);
+                }
+                RasterTaskGlyph glyph;
+                memset(&glyph, 0, sizeof(glyph));
+                glyph.Codepoint = codepoint;
+                tasks.Glyphs.push_back(glyph);
+                tasks.Tasks[task_i].GlyphsCount++;
+            }
+        }
+    }
+    if (atlas->ParallelForFn && tasks.Tasks.Size > 1)
+        atlas->ParallelForFn(tasks.Tasks.Size, RasterTaskFn, &tasks, atlas->ParallelForUserData);
+    else
+        for (int task_n = 0; task_n < tasks.Tasks.Size; task_n++)
+            RasterTaskFn(&tasks, task_n);
+
+    // Move the rendered glyphs to the cache
+    for (int task_n = 0; task_n < tasks.Tasks.Size; task_n++)
+    {
+        const RasterTask& task = tasks.Tasks[task_n];
+        GlyphCacheFont* cache_font = task.CacheFont;
+        for (int n = 0; n < task.GlyphsCount; n++)
+        {
+            RasterTaskGlyph& glyph = tasks.Glyphs[task.GlyphsStart + n];
+            CachedGlyph cached_glyph;
+            cached_glyph.Info = glyph.Info;
+            cached_glyph.PixelsOffset = -1;
+            if (glyph.Pixels)
+            {
+                const int pixels_count = (int)glyph.Info.Width * (int)glyph.Info.Height;
+                cached_glyph.PixelsOffset = cache_font->Pixels.Size;
+                cache_font->Pixels.resize(cache_font->Pixels.Size + pixels_count);
+                if (pixels_count > 0)
+                    memcpy(cache_font->Pixels.Data + cached_glyph.PixelsOffset, glyph.Pixels, (size_t)pixels_count);
+                ImGui::MemFreeThreadSafe(glyph.Pixels);
+            }
+            cache_font->GlyphsIndex[glyph.Codepoint] = cache_font->Glyphs.Size;
+            cache_font->Glyphs.push_back(cached_glyph);
+        }
+    }
 
-        if (!cfg.GlyphRanges)
-            cfg.GlyphRanges = atlas->GetGlyphRangesDefault();
-        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[ 1 ]; in_range += 2, total_ranges_count++) 
-            total_glyphs_count += (in_range[1] - in_range[0]) + 1;
+    // Gather the glyphs to add. Skip glyphs already provided by a previous font merged into the same ImFont (as FindGlyphNoFallback() would).
+    struct GlyphToAdd
+    {
+        int                 ConfigIndex;
+        ImWchar             Codepoint;
+        const CachedGlyph*  Glyph;
+    };
+    ImVector<GlyphToAdd> glyphs_to_add;
+    ImVector<stbrp_rect> glyphs_rects;
+    ImVector<ImU32> dst_font_codepoints;   // 1 bit per codepoint added to the current ImFont
+    dst_font_codepoints.resize(0x10000 / 32);
+    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    {
+        const ImFontConfig& cfg = atlas->ConfigData[input_i];
+        const GlyphCacheFont* cache_font = cache_fonts[input_i];
+        if (!cfg.MergeMode)
+            memset(dst_font_codepoints.Data, 0, (size_t)dst_font_codepoints.Size * sizeof(ImU32));
+        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1]; in_range += 2) 
+            for (uint32_t codepoint = in_range[0]; codepoint <= in_range[1]; ++codepoint) 
+            {
+                const CachedGlyph& cached_glyph = cache_font->Glyphs[cache_font->GlyphsIndex[codepoint]];
+                if (cached_glyph.PixelsOffset < 0 || (dst_font_codepoints[codepoint >> 5] & (1u << (codepoint & 31))))
+                    continue;
+                dst_font_codepoints[codepoint >> 5] |= 1u << (codepoint & 31);
+                GlyphToAdd glyph_to_add = { input_i, (ImWchar)codepoint, &cached_glyph };
+                glyphs_to_add.push_back(glyph_to_add);
+                stbrp_rect rect;
+                memset(&rect, 0, sizeof(rect));
+                rect.w = (stbrp_coord)cached_glyph.Info.Width + 1; // Account for texture filtering
+                rect.h = (stbrp_coord)cached_glyph.Info.Height + 1;
+                glyphs_rects.push_back(rect);
+            }
     }
 
     // We need a width for the skyline algorithm. Using a dumb heuristic here to decide of width. User can override TexDesiredWidth and TexGlyphPadding if they wish.
     // Width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
+    const int total_glyphs_count = glyphs_to_add.Size;
     atlas->TexWidth = (atlas->TexDesiredWidth > 0) ? atlas->TexDesiredWidth : (total_glyphs_count > 4000) ? 4096 : (total_glyphs_count > 2000) ? 2048 : (total_glyphs_count > 1000) ? 1024 : 512;
 
-    // We don't do the original first pass to determine texture height, but just rough estimate.
-    // Looks ugly inaccurate and excessive, but AFAIK with FreeType we actually need to render glyphs to get exact sizes.
-    // Alternatively, we could just render all glyphs into a big shadow buffer, get their sizes, do the rectangle packing and just copy back from the 
-    // shadow buffer to the texture buffer. Will give us an accurate texture height, but eat a lot of temp memory. Probably no one will notice.)
-    const int total_rects = total_glyphs_count + atlas->CustomRects.size();
-    float min_rects_per_row = ceilf((atlas->TexWidth / (max_glyph_size.x + 1.0f)));
-    float min_rects_per_column = ceilf(total_rects / min_rects_per_row);
-    atlas->TexHeight = (int)(min_rects_per_column * (max_glyph_size.y + 1.0f));
+    // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
+    // Glyphs sizes are known before allocating the texture, so its height is exact.
+    const int max_tex_height = 1024*32;
+    ImVector<stbrp_node> pack_nodes;
+    pack_nodes.resize(atlas->TexWidth);
+    stbrp_context context;
+    stbrp_init_target(&context, atlas->TexWidth, max_tex_height, pack_nodes.Data, pack_nodes.Size);
+    ImFontAtlasBuildPackCustomRects(atlas, &context);
+    stbrp_pack_rects(&context, glyphs_rects.Data, glyphs_rects.Size);
+    for (int n = 0; n < glyphs_rects.Size; n++)
+        if (glyphs_rects[n].was_packed)
+            atlas->TexHeight = ImMax(atlas->TexHeight, glyphs_rects[n].y + glyphs_rects[n].h);
 
     // Create texture
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
@@ -301,79 +558,71 @@ bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags)
     atlas->TexPixelsAlpha8 = (unsigned char*)ImGui::MemAlloc(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
 
-    // Start packing
-    ImVector<stbrp_node> pack_nodes;
-    pack_nodes.resize(total_rects);
-    stbrp_context context;
-    stbrp_init_target(&context, atlas->TexWidth, atlas->TexHeight, pack_nodes.Data, total_rects);
-
-    // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    ImFontAtlasBuildPackCustomRects(atlas, &context);
-
-    // Render characters, setup ImFont and glyphs for runtime
-    for (int input_i = 0; input_i < atlas->ConfigData.Size; input_i++)
+    // Copy glyphs to the texture, setup ImFont and glyphs for runtime
+    for (int input_i = 0, glyph_n = 0; input_i < atlas->ConfigData.Size; input_i++)
     {
         ImFontConfig& cfg = atlas->ConfigData[input_i];
-        FreeTypeFont& font_face = fonts[input_i];
+        const GlyphCacheFont* cache_font = cache_fonts[input_i];
         ImFont* dst_font = cfg.DstFont;
-        if (cfg.MergeMode)
-            dst_font->BuildLookupTable();
 
-        const float ascent = font_face.Info.Ascender;
-        const float descent = font_face.Info.Descender;
+        // Glyphs are rasterized at SizePixels * RasterizerScale, positions and metrics are scaled back to SizePixels
+        const float rasterizer_scale_inv = 1.0f / cfg.RasterizerScale;
+        const float ascent = cache_font->Info.Ascender * rasterizer_scale_inv;
+        const float descent = cache_font->Info.Descender * rasterizer_scale_inv;
         ImFontAtlasBuildSetupFont(atlas, dst_font, &cfg, ascent, descent);
         const float off_x = cfg.GlyphOffset.x;
         const float off_y = cfg.GlyphOffset.y + (float)(int)(dst_font->Ascent + 0.5f);
 
-        bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
+        bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f) && sdf_spread == 0;
         unsigned char multiply_table[256];
         if (multiply_enabled)
             ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
 
-        for (const ImWchar* in_range = cfg.GlyphRanges; in_range[0] && in_range[1]; in_range += 2) 
+        for (; glyph_n < glyphs_to_add.Size && glyphs_to_add[glyph_n].ConfigIndex == input_i; glyph_n++)
         {
-            for (uint32_t codepoint = in_range[0]; codepoint <= in_range[1]; ++codepoint) 
-            {
-                if (cfg.MergeMode && dst_font->FindGlyphNoFallback((unsigned short)codepoint))
-                    continue;
-
-                FT_Glyph ft_glyph = NULL;
-                FT_BitmapGlyph ft_glyph_bitmap = NULL; // NB: will point to bitmap within FT_Glyph
-                GlyphInfo glyph_info;
-                if (!font_face.CalcGlyphInfo(codepoint, glyph_info, ft_glyph, ft_glyph_bitmap))
-                    continue;
-
-                // Pack rectangle
-                stbrp_rect rect;
-                rect.w = (uint16_t)glyph_info.Width + 1; // Account for texture filtering
-                rect.h = (uint16_t)glyph_info.Height + 1;
-                stbrp_pack_rects(&context, &rect, 1);
-
-                // Copy rasterized pixels to main texture
-                uint8_t* blit_dst = atlas->TexPixelsAlpha8 + rect.y * atlas->TexWidth + rect.x;
-                font_face.BlitGlyph(ft_glyph_bitmap, blit_dst, atlas->TexWidth, multiply_enabled ? multiply_table : NULL);
-                FT_Done_Glyph(ft_glyph);
-
-                // Register glyph
-                dst_font->AddGlyph((ImWchar)codepoint, 
-                    glyph_info.OffsetX + off_x, 
-                    glyph_info.OffsetY + off_y, 
-                    glyph_info.OffsetX + off_x + glyph_info.Width, 
-                    glyph_info.OffsetY + off_y + glyph_info.Height,
-                    rect.x / (float)atlas->TexWidth, 
-                    rect.y / (float)atlas->TexHeight, 
-                    (rect.x + glyph_info.Width) / (float)atlas->TexWidth, 
-                    (rect.y + glyph_info.Height) / (float)atlas->TexHeight,
-                    glyph_info.AdvanceX);
-            }
+            const GlyphInfo& glyph_info = glyphs_to_add[glyph_n].Glyph->Info;
+            const stbrp_rect& rect = glyphs_rects[glyph_n];
+            if (!rect.was_packed)
+                continue;
+
+            // Copy rasterized pixels to main texture
+            uint8_t* blit_dst = atlas->TexPixelsAlpha8 + rect.y * atlas->TexWidth + rect.x;
+            if (glyph_info.Width > 0 && glyph_info.Height > 0)
+                BlitGlyph(cache_font->Pixels.Data + glyphs_to_add[glyph_n].Glyph->PixelsOffset, (uint32_t)glyph_info.Width, (uint32_t)glyph_info.Width, (uint32_t)glyph_info.Height, blit_dst, atlas->TexWidth, multiply_enabled ? multiply_table : NULL);
+
+            // Register glyph
+            dst_font->AddGlyph(glyphs_to_add[glyph_n].Codepoint, 
+                glyph_info.OffsetX * rasterizer_scale_inv + off_x, 
+                glyph_info.OffsetY * rasterizer_scale_inv + off_y, 
+                (glyph_info.OffsetX + glyph_info.Width) * rasterizer_scale_inv + off_x, 
+                (glyph_info.OffsetY + glyph_info.Height) * rasterizer_scale_inv + off_y,
+                rect.x / (float)atlas->TexWidth, 
+                rect.y / (float)atlas->TexHeight, 
+                (rect.x + glyph_info.Width) / (float)atlas->TexWidth, 
+                (rect.y + glyph_info.Height) / (float)atlas->TexHeight,
+                glyph_info.AdvanceX * rasterizer_scale_inv);
         }
     }
 
-    // Cleanup
+    // Cleanup, free the cached sizes which were not used by the last builds
     for (int n = 0; n < fonts.Size; n++)
         fonts[n].Shutdown();
+    if (temp_cache)
+    {
+        DestroyGlyphCache(temp_cache);
+    }
+    else
+    {
+        for (int n = cache->Fonts.Size - 1; n >= 0; n--)
+            if (cache->Fonts[n]->LastUsedBuild < cache->BuildCount - cache->MaxUnusedBuilds)
+            {
+                IM_DELETE(cache->Fonts[n]);
+                cache->Fonts.erase(cache->Fonts.Data + n);
+            }
+    }
 
     ImFontAtlasBuildFinish(atlas);
+    ImGui::ProfilerPopZone();
 
     return true;
 }
@@ -27,5 +27,14 @@ namespace ImGuiFreeType
         Oblique         = 1 << 6    // Styling: Should we slant the font, emulating italic style?
     };
 
-    IMGUI_API bool BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags = 0);
+    // Rendered glyphs kept across BuildFontAtlas() calls, keyed by font data, size, flags and codepoint.
+    // Rebuilding the atlas (e.g. after a DPI change back and forth, or after adding a font) only renders the glyphs of new fonts/sizes.
+    // Sizes not used by the last 'max_unused_builds' builds are freed.
+    struct GlyphCache;
+    IMGUI_API GlyphCache*   CreateGlyphCache(int max_unused_builds = 4);
+    IMGUI_API void          DestroyGlyphCache(GlyphCache* cache);
+
+    // Glyphs are rendered in parallel with atlas->ParallelForFn when set, each task using its own FT_Library.
+    // cache = NULL: render all glyphs, only keep them during the build.
+    IMGUI_API bool BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags = 0, GlyphCache* cache = NULL);
 }
@@ -0,0 +1,574 @@
+// Delta-encoded streaming of ImDrawData for Dear ImGui, to display an application running on another machine
+// See README.md for usage.
+
+// Message format (native endianness, no padding). Every message starts with { u32 size (including this field), u8 type }.
+//   Texture:   u64 sender_tex_id, varint width, varint height, u8 bytes_per_pixel, pixels.
+//   Frame:     u8 version, u8 sizeof(ImDrawVert), u8 sizeof(ImDrawIdx), varint frame, varint damage_rects_count, damage_rects_count x f32[4],
+//              varint lists_count, then for each list: u8 kind (ImGuiRemoteList_), u32 hash, [u32 base_hash for delta lists],
+//              vertices, indices, varint cmd_count, cmd_count x { varint elem_count, f32 clip_rect[4], u64 texture_id }.
+//              Ref lists carry no vertices/indices/commands: they are the list with the same hash in the previous frame.
+//              Full lists store varint count followed by raw elements.
+//              Delta lists store varint count followed by runs against the base list (with the same hash in the previous frame):
+//              each run is a varint (n << 2 | ImGuiRemoteRun_), and runs are read until count elements are produced.
+//              Indices of delta lists are diffed as differences between consecutive indices, so inserting vertices in a list doesn't change the indices after them.
+
+#include "imgui_remote.h"
+#include "imgui_internal.h" // ImHash
+#if defined(_MSC_VER) && _MSC_VER <= 1500 // MSVC 2008 or earlier
+#include <stddef.h>     // intptr_t
+#else
+#include <stdint.h>     // intptr_t
+#endif
+
+enum ImGuiRemoteList_
+{
+    ImGuiRemoteList_Ref     = 0,
+    ImGuiRemoteList_Full    = 1,
+    ImGuiRemoteList_Delta   = 2
+};
+
+enum ImGuiRemoteRun_
+{
+    ImGuiRemoteRun_Copy     = 0,    // Copy n elements from the base list, advance in both lists
+    ImGuiRemoteRun_Literal  = 1,    // n raw elements follow, replacing n elements of the base list
+    ImGuiRemoteRun_Seek     = 2     // Move in the base list by zigzag-encoded n elements (elements were inserted or removed)
+};
+
+static const unsigned char ImGuiRemoteVersion = 1;
+static const int ImGuiRemoteMaxSeek = 16;       // Max distance searched in the base list to find matching elements again
+static const int ImGuiRemoteSeekMatchLen = 4;   // Number of consecutive elements which must match to seek
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+static void WriteBytes(ImVector<unsigned char>* buf, const void* data, int size)
+{
+    const int pos = buf->Size;
+    buf->resize(pos + size);
+    if (size > 0)
+        memcpy(buf->Data + pos, data, (size_t)size);
+}
+
+template<typename T> static void WriteValue(ImVector<unsigned char>* buf, T v) { WriteBytes(buf, &v, (int)sizeof(T)); }
+
+static void WriteVarint(ImVector<unsigned char>* buf, unsigned int v)
+{
+    while (v >= 0x80)
+    {
+        buf->push_back((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    buf->push_back((unsigned char)v);
+}
+
+struct ImGuiRemoteReader
+{
+    const unsigned char*    Data;
+    const unsigned char*    End;
+    bool                    Error;
+
+    ImGuiRemoteReader(const unsigned char* data, int size) { Data = data; End = data + size; Error = false; }
+    bool ReadBytes(void* dst, int size)
+    {
+        if (Error || size < 0 || End - Data < size)
+            return !(Error = true);
+        if (size > 0)
+            memcpy(dst, Data, (size_t)size);
+        Data += size;
+        return true;
+    }
+    template<typename T> T ReadValue() { T v = T(); ReadBytes(&v, (int)sizeof(T)); return v; }
+    unsigned int ReadVarint()
+    {
+        unsigned int v = 0;
+        for (int shift = 0; shift < 35; shift += 7)
+        {
+            if (Error || Data >= End)
+                break;
+            const unsigned char b = *Data++;
+            v |= (unsigned int)(b & 0x7F) << shift;
+            if (!(b & 0x80))
+                return v;
+        }
+        Error = true;
+        return 0;
+    }
+    int ReadCount(int max_count) { unsigned int v = ReadVarint(); if (v > (unsigned int)max_count) { Error = true; return 0; } return (int)v; }
+};
+
+// Write the runs turning base[] into curr[]
+template<typename T>
+static void EncodeRuns(ImVector<unsigned char>* buf, const T* base, int base_count, const T* curr, int curr_count)
+{
+    int i = 0, j = 0, literal_start = -1;
+    while (i <= curr_count)
+    {
+        const bool at_end = (i == curr_count);
+        const bool match = !at_end && j >= 0 && j < base_count && memcmp(&curr[i], &base[j], sizeof(T)) == 0;
+        int seek = 0;
+        if (!at_end && !match)
+        {
+            // Try to find the following elements at a close position in the base list
+            const int match_len = ImMin(ImGuiRemoteSeekMatchLen, curr_count - i);
+            for (int dist = 1; dist <= ImGuiRemoteMaxSeek && seek == 0; dist++)
+                for (int sign = 1; sign >= -1 && seek == 0; sign -= 2)
+                {
+                    const int seek_j = j + dist * sign;
+                    if (seek_j >= 0 && seek_j + match_len <= base_count && memcmp(&curr[i], &base[seek_j], sizeof(T) * match_len) == 0)
+                        seek = dist * sign;
+                }
+        }
+        if (!at_end && !match && seek == 0)
+        {
+            if (literal_start < 0)
+                literal_start = i;
+            i++;
+            j++;
+            continue;
+        }
+        if (literal_start >= 0)
+        {
+            WriteVarint(buf, (unsigned int)((i - literal_start) << 2) | ImGuiRemoteRun_Literal);
+            WriteBytes(buf, &curr[literal_start], (i - literal_start) * (int)sizeof(T));
+            literal_start = -1;
+        }
+        if (at_end)
+            break;
+        if (seek != 0)
+        {
+            WriteVarint(buf, ((((unsigned int)seek << 1) ^ (unsigned int)(seek >> 31)) << 2) | ImGuiRemoteRun_Seek);
+            j += seek;
+            continue;
+        }
+        int copy_count = 1;
+        while (i + copy_count < curr_count && j + copy_count < base_count && memcmp(&curr[i + copy_count], &base[j + copy_count], sizeof(T)) == 0)
+            copy_count++;
+        WriteVarint(buf, (unsigned int)(copy_count << 2) | ImGuiRemoteRun_Copy);
+        i += copy_count;
+        j += copy_count;
+    }
+}
+
+template<typename T>
+static bool DecodeRuns(ImGuiRemoteReader* r, const T* base, int base_count, T* curr, int curr_count)
+{
+    int i = 0, j = 0;
+    while (i < curr_count && !r->Error)
+    {
+        const unsigned int v = r->ReadVarint();
+        const int n = (int)(v >> 2);
+        switch (v & 3)
+        {
+        case ImGuiRemoteRun_Copy:
+            if (n <= 0 || n > curr_count - i || j < 0 || n > base_count - j)
+                return false;
+            memcpy(&curr[i], &base[j], sizeof(T) * n);
+            i += n;
+            j += n;
+            break;
+        case ImGuiRemoteRun_Literal:
+            if (n <= 0 || n > curr_count - i || !r->ReadBytes(&curr[i], n * (int)sizeof(T)))
+                return false;
+            i += n;
+            j += n;
+            break;
+        case ImGuiRemoteRun_Seek:
+        {
+            const int seek = (int)(((unsigned int)n >> 1) ^ (unsigned int)-(n & 1));
+            if (seek < -ImGuiRemoteMaxSeek || seek > ImGuiRemoteMaxSeek)
+                return false;
+            j += seek;
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return !r->Error;
+}
+
+// Differences between consecutive indices (wrapping around), which don't change when vertices are inserted before the indexed ones
+static void IndicesToDeltas(const ImDrawIdx* idx, int count, ImVector<ImDrawIdx>* out)
+{
+    out->resize(count);
+    for (int n = 0; n < count; n++)
+        out->Data[n] = (ImDrawIdx)(idx[n] - (n > 0 ? idx[n - 1] : 0));
+}
+
+static ImU32 HashDrawList(const ImDrawList* draw_list)
+{
+    ImU32 hash = ImHash(draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert));
+    hash = ImHash(draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), hash);
+    for (int n = 0; n < draw_list->CmdBuffer.Size; n++)
+    {
+        const ImDrawCmd& cmd = draw_list->CmdBuffer.Data[n];
+        hash = ImHash(&cmd.ElemCount, sizeof(cmd.ElemCount), hash);
+        hash = ImHash(&cmd.ClipRect, sizeof(cmd.ClipRect), hash);
+        hash = ImHash(&cmd.TextureId, sizeof(cmd.TextureId), hash);
+    }
+    return hash;
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiDrawDataEncoder
+//-----------------------------------------------------------------------------
+
+ImGuiDrawDataEncoder::ImGuiDrawDataEncoder()
+{
+    FrameCount = 0;
+}
+
+ImGuiDrawDataEncoder::~ImGuiDrawDataEncoder()
+{
+    Reset();
+}
+
+static void BeginMessage(ImVector<unsigned char>* buf, unsigned char type)
+{
+    buf->resize(0);
+    WriteValue<ImU32>(buf, 0);
+    WriteValue<unsigned char>(buf, type);
+}
+
+static void EndMessage(ImVector<unsigned char>* buf)
+{
+    const ImU32 size = (ImU32)buf->Size;
+    memcpy(buf->Data, &size, sizeof(size));
+}
+
+void ImGuiDrawDataEncoder::EncodeFrame(const ImDrawData* draw_data)
+{
+    IM_ASSERT(draw_data != NULL && draw_data->Valid);
+    BeginMessage(&Buffer, ImGuiRemoteMsg_Frame);
+    WriteValue<unsigned char>(&Buffer, ImGuiRemoteVersion);
+    WriteValue<unsigned char>(&Buffer, (unsigned char)sizeof(ImDrawVert));
+    WriteValue<unsigned char>(&Buffer, (unsigned char)sizeof(ImDrawIdx));
+    WriteVarint(&Buffer, (unsigned int)FrameCount);
+    WriteVarint(&Buffer, (unsigned int)draw_data->DamageRectsCount);
+    WriteBytes(&Buffer, draw_data->DamageRects, draw_data->DamageRectsCount * (int)sizeof(ImVec4));
+    WriteVarint(&Buffer, (unsigned int)draw_data->CmdListsCount);
+
+    ImVector<ImDrawIdx> base_idx_deltas, curr_idx_deltas;
+    ListsTemp.resize(0);
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        // Find the same list in the previous frame, by address
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        ImGuiRemoteEncoderList* state = NULL;
+        for (int prev_n = 0; prev_n < Lists.Size && state == NULL; prev_n++)
+            if (Lists[prev_n] != NULL && Lists[prev_n]->DrawList == draw_list)
+            {
+                state = Lists[prev_n];
+                Lists[prev_n] = NULL;
+            }
+        const bool has_prev = (state != NULL);
+        if (!has_prev)
+        {
+            state = IM_NEW(ImGuiRemoteEncoderList)();
+            state->DrawList = draw_list;
+        }
+        ListsTemp.push_back(state);
+        const ImU32 prev_hash = state->Hash;
+        state->Hash = HashDrawList(draw_list);
+
+        if (has_prev && prev_hash == state->Hash)
+        {
+            WriteValue<unsigned char>(&Buffer, ImGuiRemoteList_Ref);
+            WriteValue<ImU32>(&Buffer, state->Hash);
+            continue;
+        }
+
+        const int vtx_count = draw_list->VtxBuffer.Size, idx_count = draw_list->IdxBuffer.Size;
+        if (has_prev)
+        {
+            WriteValue<unsigned char>(&Buffer, ImGuiRemoteList_Delta);
+            WriteValue<ImU32>(&Buffer, state->Hash);
+            WriteValue<ImU32>(&Buffer, prev_hash);
+            WriteVarint(&Buffer, (unsigned int)vtx_count);
+            EncodeRuns(&Buffer, state->VtxBuffer.Data, state->VtxBuffer.Size, draw_list->VtxBuffer.Data, vtx_count);
+            IndicesToDeltas(state->IdxBuffer.Data, state->IdxBuffer.Size, &base_idx_deltas);
+            IndicesToDeltas(draw_list->IdxBuffer.Data, idx_count, &curr_idx_deltas);
+            WriteVarint(&Buffer, (unsigned int)idx_count);
+            EncodeRuns(&Buffer, base_idx_deltas.Data, base_idx_deltas.Size, curr_idx_deltas.Data, idx_count);
+        }
+        else
+        {
+            WriteValue<unsigned char>(&Buffer, ImGuiRemoteList_Full);
+            WriteValue<ImU32>(&Buffer, state->Hash);
+            WriteVarint(&Buffer, (unsigned int)vtx_count);
+            WriteBytes(&Buffer, draw_list->VtxBuffer.Data, vtx_count * (int)sizeof(ImDrawVert));
+            WriteVarint(&Buffer, (unsigned int)idx_count);
+            WriteBytes(&Buffer, draw_list->IdxBuffer.Data, idx_count * (int)sizeof(ImDrawIdx));
+        }
+        WriteVarint(&Buffer, (unsigned int)draw_list->CmdBuffer.Size);
+        for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+            WriteVarint(&Buffer, cmd.ElemCount);
+            WriteValue<ImVec4>(&Buffer, cmd.ClipRect);
+            WriteValue<ImU64>(&Buffer, (ImU64)(intptr_t)cmd.TextureId);
+        }
+        state->VtxBuffer = draw_list->VtxBuffer;
+        state->IdxBuffer = draw_list->IdxBuffer;
+    }
+
+    // Lists which disappeared
+    for (int prev_n = 0; prev_n < Lists.Size; prev_n++)
+        if (Lists[prev_n] != NULL)
+            IM_DELETE(Lists[prev_n]);
+    Lists.swap(ListsTemp);
+    EndMessage(&Buffer);
+    FrameCount++;
+}
+
+void ImGuiDrawDataEncoder::EncodeTexture(ImTextureID tex_id, const unsigned char* pixels, int width, int height, int bytes_per_pixel)
+{
+    IM_ASSERT(pixels != NULL && width > 0 && height > 0 && bytes_per_pixel > 0 && bytes_per_pixel <= 4);
+    BeginMessage(&Buffer, ImGuiRemoteMsg_Texture);
+    WriteValue<ImU64>(&Buffer, (ImU64)(intptr_t)tex_id);
+    WriteVarint(&Buffer, (unsigned int)width);
+    WriteVarint(&Buffer, (unsigned int)height);
+    WriteValue<unsigned char>(&Buffer, (unsigned char)bytes_per_pixel);
+    WriteBytes(&Buffer, pixels, width * height * bytes_per_pixel);
+    EndMessage(&Buffer);
+}
+
+void ImGuiDrawDataEncoder::Reset()
+{
+    for (int n = 0; n < Lists.Size; n++)
+        IM_DELETE(Lists[n]);
+    Lists.resize(0);
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiDrawDataDecoder
+//-----------------------------------------------------------------------------
+
+ImGuiDrawDataDecoder::ImGuiDrawDataDecoder()
+{
+    FrameCount = 0;
+    RemapTextureIdFn = NULL;
+    RemapTextureIdUserData = NULL;
+}
+
+ImGuiDrawDataDecoder::~ImGuiDrawDataDecoder()
+{
+    for (int n = 0; n < Lists.Size; n++)
+        IM_DELETE(Lists[n]);
+    for (int n = 0; n < FreeLists.Size; n++)
+        IM_DELETE(FreeLists[n]);
+    for (int n = 0; n < Textures.Size; n++)
+        Textures[n].Pixels.clear();
+}
+
+int ImGuiDrawDataDecoder::GetMessageSize(const unsigned char* data, int data_size)
+{
+    if (data_size < (int)sizeof(ImU32))
+        return 0;
+    ImU32 size;
+    memcpy(&size, data, sizeof(size));
+    return (int)size;
+}
+
+ImGuiRemoteTexture* ImGuiDrawDataDecoder::FindTexture(ImU64 sender_tex_id)
+{
+    for (int n = 0; n < Textures.Size; n++)
+        if (Textures[n].SenderTexId == sender_tex_id)
+            return &Textures[n];
+    return NULL;
+}
+
+// Find a list of the previous frame, or a list already decoded in the current frame (when it was moved, or is used by several lists)
+static const ImDrawList* FindDecodedList(ImGuiDrawDataDecoder* d, ImU32 hash, int* out_prev_n)
+{
+    *out_prev_n = -1;
+    for (int n = 0; n < d->Lists.Size; n++)
+        if (d->Lists[n] != NULL && d->ListsHash[n] == hash)
+        {
+            *out_prev_n = n;
+            return d->Lists[n];
+        }
+    for (int n = 0; n < d->ListsTemp.Size; n++)
+        if (d->ListsHashTemp[n] == hash)
+            return d->ListsTemp[n];
+    return NULL;
+}
+
+static ImDrawList* AllocDecodedList(ImGuiDrawDataDecoder* d)
+{
+    if (d->FreeLists.empty())
+        return IM_NEW(ImDrawList)(NULL);
+    ImDrawList* draw_list = d->FreeLists.back();
+    d->FreeLists.pop_back();
+    return draw_list;
+}
+
+// Upper bound of the number of elements the remaining runs can produce (each run takes at least one byte and copies at most the whole base list), to reject corrupted counts before allocating
+static int GetMaxRunsCount(const ImGuiRemoteReader* r, int base_count, int elem_size)
+{
+    const ImU64 max_count = (ImU64)(r->End - r->Data) * (ImU64)(base_count + 1);
+    return (max_count < (ImU64)(INT_MAX / elem_size)) ? (int)max_count : INT_MAX / elem_size;
+}
+
+static bool DecodeFrame(ImGuiDrawDataDecoder* d, ImGuiRemoteReader* r)
+{
+    if (r->ReadValue<unsigned char>() != ImGuiRemoteVersion || r->ReadValue<unsigned char>() != sizeof(ImDrawVert) || r->ReadValue<unsigned char>() != sizeof(ImDrawIdx))
+        return false;
+    r->ReadVarint(); // Frame index
+    const int remaining_size = (int)(r->End - r->Data);
+    d->DamageRects.resize(r->ReadCount(remaining_size / (int)sizeof(ImVec4)));
+    r->ReadBytes(d->DamageRects.Data, d->DamageRects.Size * (int)sizeof(ImVec4));
+    const int lists_count = r->ReadCount(remaining_size);
+
+    d->ListsTemp.resize(0);
+    d->ListsHashTemp.resize(0);
+    ImVector<ImDrawIdx> base_idx_deltas, curr_idx_deltas;
+    for (int list_n = 0; list_n < lists_count && !r->Error; list_n++)
+    {
+        const unsigned char kind = r->ReadValue<unsigned char>();
+        const ImU32 hash = r->ReadValue<ImU32>();
+        if (kind == ImGuiRemoteList_Ref)
+        {
+            int prev_n;
+            const ImDrawList* src = FindDecodedList(d, hash, &prev_n);
+            if (src == NULL)
+                return false;
+            ImDrawList* draw_list;
+            if (prev_n >= 0)
+            {
+                draw_list = d->Lists[prev_n];   // Move from the previous frame
+                d->Lists[prev_n] = NULL;
+            }
+            else
+            {
+                draw_list = AllocDecodedList(d);
+                draw_list->CmdBuffer = src->CmdBuffer;
+                draw_list->VtxBuffer = src->VtxBuffer;
+                draw_list->IdxBuffer = src->IdxBuffer;
+            }
+            d->ListsTemp.push_back(draw_list);
+            d->ListsHashTemp.push_back(hash);
+            continue;
+        }
+
+        ImDrawList* draw_list = AllocDecodedList(d);
+        d->ListsTemp.push_back(draw_list);
+        d->ListsHashTemp.push_back(hash);
+        if (kind == ImGuiRemoteList_Full)
+        {
+            draw_list->VtxBuffer.resize(r->ReadCount((int)(r->End - r->Data) / (int)sizeof(ImDrawVert)));
+            r->ReadBytes(draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert));
+            draw_list->IdxBuffer.resize(r->ReadCount((int)(r->End - r->Data) / (int)sizeof(ImDrawIdx)));
+            r->ReadBytes(draw_list->IdxBuffer.Data, draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx));
+        }
+        else if (kind == ImGuiRemoteList_Delta)
+        {
+            int prev_n;
+            const ImDrawList* base = FindDecodedList(d, r->ReadValue<ImU32>(), &prev_n);
+            if (base == NULL)
+                return false;
+            draw_list->VtxBuffer.resize(r->ReadCount(GetMaxRunsCount(r, base->VtxBuffer.Size, (int)sizeof(ImDrawVert))));
+            if (!DecodeRuns(r, base->VtxBuffer.Data, base->VtxBuffer.Size, draw_list->VtxBuffer.Data, draw_list->VtxBuffer.Size))
+                return false;
+            IndicesToDeltas(base->IdxBuffer.Data, base->IdxBuffer.Size, &base_idx_deltas);
+            curr_idx_deltas.resize(r->ReadCount(GetMaxRunsCount(r, base_idx_deltas.Size, (int)sizeof(ImDrawIdx))));
+            if (!DecodeRuns(r, base_idx_deltas.Data, base_idx_deltas.Size, curr_idx_deltas.Data, curr_idx_deltas.Size))
+                return false;
+            draw_list->IdxBuffer.resize(curr_idx_deltas.Size);
+            for (int n = 0; n < curr_idx_deltas.Size; n++)
+                draw_list->IdxBuffer.Data[n] = (ImDrawIdx)(curr_idx_deltas.Data[n] + (n > 0 ? draw_list->IdxBuffer.Data[n - 1] : 0));
+        }
+        else
+        {
+            return false;
+        }
+        draw_list->CmdBuffer.resize(r->ReadCount((int)(r->End - r->Data)));
+        unsigned int total_elem_count = 0;
+        for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+            cmd = ImDrawCmd();
+            cmd.ElemCount = r->ReadVarint();
+            cmd.ClipRect = r->ReadValue<ImVec4>();
+            const ImU64 tex_id = r->ReadValue<ImU64>();
+            cmd.TextureId = d->RemapTextureIdFn ? d->RemapTextureIdFn(tex_id, d->RemapTextureIdUserData) : (ImTextureID)(intptr_t)tex_id;
+            total_elem_count += cmd.ElemCount;
+        }
+        if (total_elem_count > (unsigned int)draw_list->IdxBuffer.Size)
+            return false;
+        for (int n = 0; n < draw_list->IdxBuffer.Size; n++)
+            if ((unsigned int)draw_list->IdxBuffer.Data[n] >= (unsigned int)draw_list->VtxBuffer.Size)
+                return false;
+    }
+    return !r->Error;
+}
+
+int ImGuiDrawDataDecoder::DecodeMessage(const unsigned char* data, int data_size)
+{
+    const int msg_size = GetMessageSize(data, data_size);
+    if (msg_size < (int)sizeof(ImU32) + 1 || msg_size > data_size)
+        return 0;
+    ImGuiRemoteReader r(data + sizeof(ImU32), msg_size - (int)sizeof(ImU32));
+    const unsigned char type = r.ReadValue<unsigned char>();
+    if (type == ImGuiRemoteMsg_Texture)
+    {
+        const ImU64 sender_tex_id = r.ReadValue<ImU64>();
+        const int width = r.ReadCount(1 << 14), height = r.ReadCount(1 << 14);
+        const int bytes_per_pixel = r.ReadValue<unsigned char>();
+        if (r.Error || width <= 0 || height <= 0 || bytes_per_pixel <= 0 || bytes_per_pixel > 4)
+            return 0;
+        ImGuiRemoteTexture* tex = FindTexture(sender_tex_id);
+        if (tex == NULL)
+        {
+            Textures.resize(Textures.Size + 1);
+            tex = &Textures.back();
+            IM_PLACEMENT_NEW(tex) ImGuiRemoteTexture();
+            tex->SenderTexId = sender_tex_id;
+        }
+        tex->Width = width;
+        tex->Height = height;
+        tex->BytesPerPixel = bytes_per_pixel;
+        tex->Pixels.resize(width * height * bytes_per_pixel);
+        if (!r.ReadBytes(tex->Pixels.Data, tex->Pixels.Size))
+            return 0;
+        tex->Version++;
+        return ImGuiRemoteMsg_Texture;
+    }
+    if (type != ImGuiRemoteMsg_Frame)
+        return 0;
+
+    // Lists of the previous frame which were not moved to the new frame are recycled. On error, the new frame is dropped too: the sender must call ImGuiDrawDataEncoder::Reset().
+    const bool ok = DecodeFrame(this, &r);
+    for (int n = 0; n < Lists.Size; n++)
+        if (Lists[n] != NULL)
+            FreeLists.push_back(Lists[n]);
+    if (!ok)
+        for (int n = 0; n < ListsTemp.Size; n++)
+            FreeLists.push_back(ListsTemp[n]);
+    Lists.swap(ListsTemp);
+    ListsHash.swap(ListsHashTemp);
+    ListsTemp.resize(0);
+    ListsHashTemp.resize(0);
+    if (!ok)
+    {
+        Lists.resize(0);
+        ListsHash.resize(0);
+        DrawData.Clear();
+        return 0;
+    }
+
+    DrawData.Clear();
+    DrawData.Valid = true;
+    DrawData.CmdLists = Lists.Size > 0 ? Lists.Data : NULL;
+    DrawData.CmdListsCount = Lists.Size;
+    for (int n = 0; n < Lists.Size; n++)
+    {
+        DrawData.TotalVtxCount += Lists[n]->VtxBuffer.Size;
+        DrawData.TotalIdxCount += Lists[n]->IdxBuffer.Size;
+    }
+    DrawData.DamageRects = DamageRects.Size > 0 ? DamageRects.Data : NULL;
+    DrawData.DamageRectsCount = DamageRects.Size;
+    FrameCount++;
+    return ImGuiRemoteMsg_Frame;
+}
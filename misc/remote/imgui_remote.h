@@ -0,0 +1,75 @@
+// Delta-encoded streaming of ImDrawData for Dear ImGui, to display an application running on another machine
+// See README.md for usage.
+
+#pragma once
+
+#include "imgui.h"      // IMGUI_API, ImDrawData, ImDrawList, ImVector
+
+// Message types, first byte after the size of each message
+enum ImGuiRemoteMsg_
+{
+    ImGuiRemoteMsg_Frame    = 'F',  // Draw lists of a frame
+    ImGuiRemoteMsg_Texture  = 'T'   // Contents of a texture
+};
+
+// State kept by the encoder for each draw list sent in the previous frame (internal)
+struct ImGuiRemoteEncoderList
+{
+    const ImDrawList*       DrawList;   // Identity of the list on the sender side
+    ImU32                   Hash;       // Hash of the contents sent, used by the decoder to find the list again
+    ImVector<ImDrawVert>    VtxBuffer;  // Copy of the vertices sent, to compute the next delta
+    ImVector<ImDrawIdx>     IdxBuffer;
+
+    ImGuiRemoteEncoderList()   { DrawList = NULL; Hash = 0; }
+};
+
+// Encode ImDrawData into messages. Each frame references the draw lists of the previous frame: unchanged lists are sent as a hash, changed lists as runs of modified vertices/indices.
+struct IMGUI_API ImGuiDrawDataEncoder
+{
+    ImVector<unsigned char>         Buffer;         // Output of the last Encode*() call, one complete message. Send it as is.
+    int                             FrameCount;     // Number of frames encoded so far
+    ImVector<ImGuiRemoteEncoderList*> Lists;        // Draw lists of the previous frame (owned)
+    ImVector<ImGuiRemoteEncoderList*> ListsTemp;
+
+    ImGuiDrawDataEncoder();
+    ~ImGuiDrawDataEncoder();
+    void        EncodeFrame(const ImDrawData* draw_data);   // Call after ImGui::Render(). Draw callbacks are not sent.
+    void        EncodeTexture(ImTextureID tex_id, const unsigned char* pixels, int width, int height, int bytes_per_pixel); // Send texture contents (e.g. font atlas), so the receiver can upload them.
+    void        Reset();                                    // Forget the previous frame, so the next one is encoded in full. Call when a new receiver connects.
+};
+
+// Texture received by ImGuiDrawDataDecoder
+struct ImGuiRemoteTexture
+{
+    ImU64                   SenderTexId;    // ImTextureID on the sender side
+    int                     Width, Height;
+    int                     BytesPerPixel;
+    ImVector<unsigned char> Pixels;
+    int                     Version;        // Incremented every time the texture is received
+
+    ImGuiRemoteTexture()    { SenderTexId = 0; Width = Height = BytesPerPixel = 0; Version = 0; }
+};
+
+// Decode messages written by ImGuiDrawDataEncoder.
+struct IMGUI_API ImGuiDrawDataDecoder
+{
+    ImDrawData                      DrawData;       // Last decoded frame, valid after DecodeMessage() returned ImGuiRemoteMsg_Frame
+    int                             FrameCount;     // Number of frames decoded so far
+    ImVector<ImGuiRemoteTexture>    Textures;       // Textures received so far. Pixels of a texture stay at the same address until it is received again.
+    ImTextureID                     (*RemapTextureIdFn)(ImU64 sender_tex_id, void* user_data);  // = NULL     // Map the ImTextureID of the sender to one of yours (e.g. a texture created from Textures[]). NULL: keep the value of the sender.
+    void*                           RemapTextureIdUserData;
+
+    // Internal
+    ImVector<ImDrawList*>           Lists;          // Draw lists of the last decoded frame (owned)
+    ImVector<ImU32>                 ListsHash;
+    ImVector<ImDrawList*>           ListsTemp;
+    ImVector<ImU32>                 ListsHashTemp;
+    ImVector<ImDrawList*>           FreeLists;      // Lists recycled for the next frames
+    ImVector<ImVec4>                DamageRects;
+
+    ImGuiDrawDataDecoder();
+    ~ImGuiDrawDataDecoder();
+    static int  GetMessageSize(const unsigned char* data, int data_size);   // Size of the message at the start of data[], or 0 when fewer than 4 bytes are available
+    int         DecodeMessage(const unsigned char* data, int data_size);    // Decode one complete message. Returns its type (ImGuiRemoteMsg_Frame or ImGuiRemoteMsg_Texture), or 0 on error (corrupted stream, or frame referencing lists never received: call ImGuiDrawDataEncoder::Reset() on the sender side).
+    ImGuiRemoteTexture* FindTexture(ImU64 sender_tex_id);
+};
@@ -0,0 +1,366 @@
+// Record and replay of ImGuiIO inputs, and dump of ImDrawData, for Dear ImGui
+// See README.md for usage.
+
+// File formats (native endianness, no padding):
+//   Inputs:    header { char[4] "IMRP", u32 version, u16 keys_count, u16 nav_inputs_count }, then for each frame:
+//              u16 changed_mask (ImGuiReplayField_), followed by the fields which changed since the previous frame, in the order of ImGuiReplayField_.
+//   Draw data: header { char[4] "IMDD", u32 version, u32 sizeof(ImDrawVert), u32 sizeof(ImDrawIdx), i32 vtx_format }, then for each frame:
+//              i32 frame, i32 lists_count, then for each list: i32 cmd_count, i32 vtx_count, i32 idx_count,
+//              cmd_count x { u32 elem_count, f32 clip_rect[4], u64 texture_id, u32 has_callback }, vertices, indices.
+
+#include "imgui_replay.h"
+#include "imgui_internal.h" // ImFileOpen
+#if defined(_MSC_VER) && _MSC_VER <= 1500 // MSVC 2008 or earlier
+#include <stddef.h>     // intptr_t
+#else
+#include <stdint.h>     // intptr_t
+#endif
+
+enum ImGuiReplayField_
+{
+    ImGuiReplayField_DeltaTime      = 1 << 0,   // f32
+    ImGuiReplayField_DisplaySize    = 1 << 1,   // f32 x2
+    ImGuiReplayField_MousePos       = 1 << 2,   // f32 x2
+    ImGuiReplayField_MouseDown      = 1 << 3,   // u8 bitmask
+    ImGuiReplayField_MouseWheel     = 1 << 4,   // f32 x2 (vertical, horizontal)
+    ImGuiReplayField_KeyMods        = 1 << 5,   // u8 bitmask (ctrl, shift, alt, super)
+    ImGuiReplayField_KeysDown       = 1 << 6,   // u16 count, count x u16 index of the keys which changed state
+    ImGuiReplayField_Characters     = 1 << 7,   // u8 count, count x u16 character
+    ImGuiReplayField_NavInputs      = 1 << 8    // u8 count, count x { u8 index, f32 value } for the inputs which changed
+};
+
+static const unsigned int ImGuiReplayVersion = 1;
+
+static void WriteBytes(FILE* f, const void* data, size_t size)  { fwrite(data, 1, size, f); }
+static bool ReadBytes(FILE* f, void* data, size_t size)         { return fread(data, 1, size, f) == size; }
+
+template<typename T> static void WriteValue(FILE* f, T v)       { WriteBytes(f, &v, sizeof(T)); }
+template<typename T> static bool ReadValue(FILE* f, T* v)       { return ReadBytes(f, v, sizeof(T)); }
+
+//-----------------------------------------------------------------------------
+// ImGuiReplayInputs
+//-----------------------------------------------------------------------------
+
+void ImGuiReplayInputs::CopyFrom(const ImGuiIO& io)
+{
+    DeltaTime = io.DeltaTime;
+    DisplaySize = io.DisplaySize;
+    MousePos = io.MousePos;
+    memcpy(MouseDown, io.MouseDown, sizeof(MouseDown));
+    MouseWheel = io.MouseWheel;
+    MouseWheelH = io.MouseWheelH;
+    KeyCtrl = io.KeyCtrl;
+    KeyShift = io.KeyShift;
+    KeyAlt = io.KeyAlt;
+    KeySuper = io.KeySuper;
+    memcpy(KeysDown, io.KeysDown, sizeof(KeysDown));
+    memcpy(InputCharacters, io.InputCharacters, sizeof(InputCharacters));
+    memcpy(NavInputs, io.NavInputs, sizeof(NavInputs));
+}
+
+void ImGuiReplayInputs::CopyTo(ImGuiIO& io) const
+{
+    io.DeltaTime = DeltaTime;
+    io.DisplaySize = DisplaySize;
+    io.MousePos = MousePos;
+    memcpy(io.MouseDown, MouseDown, sizeof(MouseDown));
+    io.MouseWheel = MouseWheel;
+    io.MouseWheelH = MouseWheelH;
+    io.KeyCtrl = KeyCtrl;
+    io.KeyShift = KeyShift;
+    io.KeyAlt = KeyAlt;
+    io.KeySuper = KeySuper;
+    memcpy(io.KeysDown, KeysDown, sizeof(KeysDown));
+    memcpy(io.InputCharacters, InputCharacters, sizeof(InputCharacters));
+    memcpy(io.NavInputs, NavInputs, sizeof(NavInputs));
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiInputRecorder
+//-----------------------------------------------------------------------------
+
+ImGuiInputRecorder::ImGuiInputRecorder()
+{
+    File = NULL;
+    FrameCount = 0;
+}
+
+ImGuiInputRecorder::~ImGuiInputRecorder()
+{
+    Close();
+}
+
+bool ImGuiInputRecorder::Open(const char* filename)
+{
+    Close();
+    if ((File = ImFileOpen(filename, "wb")) == NULL)
+        return false;
+    WriteBytes(File, "IMRP", 4);
+    WriteValue<ImU32>(File, ImGuiReplayVersion);
+    WriteValue<unsigned short>(File, (unsigned short)IM_ARRAYSIZE(Prev.KeysDown));
+    WriteValue<unsigned short>(File, (unsigned short)IM_ARRAYSIZE(Prev.NavInputs));
+    FrameCount = 0;
+    Prev = ImGuiReplayInputs();
+    return true;
+}
+
+void ImGuiInputRecorder::Close()
+{
+    if (File)
+        fclose(File);
+    File = NULL;
+}
+
+void ImGuiInputRecorder::RecordFrame(const ImGuiIO& io)
+{
+    if (File == NULL)
+        return;
+    ImGuiReplayInputs cur;
+    cur.CopyFrom(io);
+
+    // Compare with the previous frame
+    unsigned char mouse_down = 0, mouse_down_prev = 0;
+    for (int n = 0; n < IM_ARRAYSIZE(cur.MouseDown); n++)
+    {
+        mouse_down |= (cur.MouseDown[n] ? 1 : 0) << n;
+        mouse_down_prev |= (Prev.MouseDown[n] ? 1 : 0) << n;
+    }
+    const unsigned char key_mods = (unsigned char)((cur.KeyCtrl ? 1 : 0) | (cur.KeyShift ? 2 : 0) | (cur.KeyAlt ? 4 : 0) | (cur.KeySuper ? 8 : 0));
+    const unsigned char key_mods_prev = (unsigned char)((Prev.KeyCtrl ? 1 : 0) | (Prev.KeyShift ? 2 : 0) | (Prev.KeyAlt ? 4 : 0) | (Prev.KeySuper ? 8 : 0));
+    int keys_changed = 0, nav_inputs_changed = 0, chars_count = 0;
+    for (int n = 0; n < IM_ARRAYSIZE(cur.KeysDown); n++)
+        keys_changed += (cur.KeysDown[n] != Prev.KeysDown[n]) ? 1 : 0;
+    for (int n = 0; n < IM_ARRAYSIZE(cur.NavInputs); n++)
+        nav_inputs_changed += (cur.NavInputs[n] != Prev.NavInputs[n]) ? 1 : 0;
+    while (chars_count < IM_ARRAYSIZE(cur.InputCharacters) - 1 && cur.InputCharacters[chars_count] != 0)
+        chars_count++;
+
+    unsigned short mask = 0;
+    if (cur.DeltaTime != Prev.DeltaTime)                                                mask |= ImGuiReplayField_DeltaTime;
+    if (cur.DisplaySize.x != Prev.DisplaySize.x || cur.DisplaySize.y != Prev.DisplaySize.y) mask |= ImGuiReplayField_DisplaySize;
+    if (cur.MousePos.x != Prev.MousePos.x || cur.MousePos.y != Prev.MousePos.y)         mask |= ImGuiReplayField_MousePos;
+    if (mouse_down != mouse_down_prev)                                                  mask |= ImGuiReplayField_MouseDown;
+    if (cur.MouseWheel != Prev.MouseWheel || cur.MouseWheelH != Prev.MouseWheelH)       mask |= ImGuiReplayField_MouseWheel;
+    if (key_mods != key_mods_prev)                                                      mask |= ImGuiReplayField_KeyMods;
+    if (keys_changed > 0)                                                               mask |= ImGuiReplayField_KeysDown;
+    if (memcmp(cur.InputCharacters, Prev.InputCharacters, sizeof(cur.InputCharacters)) != 0) mask |= ImGuiReplayField_Characters;
+    if (nav_inputs_changed > 0)                                                         mask |= ImGuiReplayField_NavInputs;
+
+    // Write the fields which changed
+    WriteValue<unsigned short>(File, mask);
+    if (mask & ImGuiReplayField_DeltaTime)
+        WriteValue<float>(File, cur.DeltaTime);
+    if (mask & ImGuiReplayField_DisplaySize)
+        { WriteValue<float>(File, cur.DisplaySize.x); WriteValue<float>(File, cur.DisplaySize.y); }
+    if (mask & ImGuiReplayField_MousePos)
+        { WriteValue<float>(File, cur.MousePos.x); WriteValue<float>(File, cur.MousePos.y); }
+    if (mask & ImGuiReplayField_MouseDown)
+        WriteValue<unsigned char>(File, mouse_down);
+    if (mask & ImGuiReplayField_MouseWheel)
+        { WriteValue<float>(File, cur.MouseWheel); WriteValue<float>(File, cur.MouseWheelH); }
+    if (mask & ImGuiReplayField_KeyMods)
+        WriteValue<unsigned char>(File, key_mods);
+    if (mask & ImGuiReplayField_KeysDown)
+    {
+        WriteValue<unsigned short>(File, (unsigned short)keys_changed);
+        for (int n = 0; n < IM_ARRAYSIZE(cur.KeysDown); n++)
+            if (cur.KeysDown[n] != Prev.KeysDown[n])
+                WriteValue<unsigned short>(File, (unsigned short)n);
+    }
+    if (mask & ImGuiReplayField_Characters)
+    {
+        WriteValue<unsigned char>(File, (unsigned char)chars_count);
+        for (int n = 0; n < chars_count; n++)
+            WriteValue<unsigned short>(File, (unsigned short)cur.InputCharacters[n]);
+    }
+    if (mask & ImGuiReplayField_NavInputs)
+    {
+        WriteValue<unsigned char>(File, (unsigned char)nav_inputs_changed);
+        for (int n = 0; n < IM_ARRAYSIZE(cur.NavInputs); n++)
+            if (cur.NavInputs[n] != Prev.NavInputs[n])
+            {
+                WriteValue<unsigned char>(File, (unsigned char)n);
+                WriteValue<float>(File, cur.NavInputs[n]);
+            }
+    }
+
+    Prev = cur;
+    FrameCount++;
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiInputPlayer
+//-----------------------------------------------------------------------------
+
+ImGuiInputPlayer::ImGuiInputPlayer()
+{
+    File = NULL;
+    FrameCount = 0;
+}
+
+ImGuiInputPlayer::~ImGuiInputPlayer()
+{
+    Close();
+}
+
+bool ImGuiInputPlayer::Open(const char* filename)
+{
+    Close();
+    if ((File = ImFileOpen(filename, "rb")) == NULL)
+        return false;
+    char magic[4];
+    ImU32 version = 0;
+    unsigned short keys_count = 0, nav_inputs_count = 0;
+    if (!ReadBytes(File, magic, 4) || memcmp(magic, "IMRP", 4) != 0 || !ReadValue(File, &version) || version != ImGuiReplayVersion ||
+        !ReadValue(File, &keys_count) || keys_count != IM_ARRAYSIZE(Current.KeysDown) || !ReadValue(File, &nav_inputs_count) || nav_inputs_count != IM_ARRAYSIZE(Current.NavInputs))
+    {
+        Close();
+        return false;
+    }
+    FrameCount = 0;
+    Current = ImGuiReplayInputs();
+    return true;
+}
+
+void ImGuiInputPlayer::Close()
+{
+    if (File)
+        fclose(File);
+    File = NULL;
+}
+
+bool ImGuiInputPlayer::PlayFrame(ImGuiIO& io)
+{
+    if (File == NULL)
+        return false;
+    unsigned short mask;
+    if (!ReadValue(File, &mask))
+        return false;
+
+    // Apply the changes to a copy, so a truncated record leaves the state untouched
+    ImGuiReplayInputs next = Current;
+    bool ok = true;
+    if (mask & ImGuiReplayField_DeltaTime)
+        ok &= ReadValue(File, &next.DeltaTime);
+    if (mask & ImGuiReplayField_DisplaySize)
+        ok &= ReadValue(File, &next.DisplaySize.x) && ReadValue(File, &next.DisplaySize.y);
+    if (mask & ImGuiReplayField_MousePos)
+        ok &= ReadValue(File, &next.MousePos.x) && ReadValue(File, &next.MousePos.y);
+    if (mask & ImGuiReplayField_MouseDown)
+    {
+        unsigned char mouse_down = 0;
+        ok &= ReadValue(File, &mouse_down);
+        for (int n = 0; n < IM_ARRAYSIZE(next.MouseDown); n++)
+            next.MouseDown[n] = (mouse_down & (1 << n)) != 0;
+    }
+    if (mask & ImGuiReplayField_MouseWheel)
+        ok &= ReadValue(File, &next.MouseWheel) && ReadValue(File, &next.MouseWheelH);
+    if (mask & ImGuiReplayField_KeyMods)
+    {
+        unsigned char key_mods = 0;
+        ok &= ReadValue(File, &key_mods);
+        next.KeyCtrl = (key_mods & 1) != 0;
+        next.KeyShift = (key_mods & 2) != 0;
+        next.KeyAlt = (key_mods & 4) != 0;
+        next.KeySuper = (key_mods & 8) != 0;
+    }
+    if (mask & ImGuiReplayField_KeysDown)
+    {
+        unsigned short count = 0, key_index = 0;
+        ok &= ReadValue(File, &count);
+        for (int n = 0; ok && n < count; n++)
+            if ((ok &= ReadValue(File, &key_index) && key_index < IM_ARRAYSIZE(next.KeysDown)))
+                next.KeysDown[key_index] = !next.KeysDown[key_index];
+    }
+    if (mask & ImGuiReplayField_Characters)
+    {
+        unsigned char count = 0;
+        unsigned short c = 0;
+        ok &= ReadValue(File, &count) && count < IM_ARRAYSIZE(next.InputCharacters);
+        memset(next.InputCharacters, 0, sizeof(next.InputCharacters));
+        for (int n = 0; ok && n < count; n++)
+            if ((ok &= ReadValue(File, &c)))
+                next.InputCharacters[n] = (ImWchar)c;
+    }
+    if (mask & ImGuiReplayField_NavInputs)
+    {
+        unsigned char count = 0, nav_index = 0;
+        ok &= ReadValue(File, &count);
+        for (int n = 0; ok && n < count; n++)
+            if ((ok &= ReadValue(File, &nav_index) && nav_index < IM_ARRAYSIZE(next.NavInputs)))
+                ok &= ReadValue(File, &next.NavInputs[nav_index]);
+    }
+    if (!ok)
+        return false;
+
+    Current = next;
+    Current.CopyTo(io);
+    FrameCount++;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiDrawDataDumper
+//-----------------------------------------------------------------------------
+
+ImGuiDrawDataDumper::ImGuiDrawDataDumper()
+{
+    File = NULL;
+    FrameCount = 0;
+}
+
+ImGuiDrawDataDumper::~ImGuiDrawDataDumper()
+{
+    Close();
+}
+
+bool ImGuiDrawDataDumper::Open(const char* filename)
+{
+    Close();
+    if ((File = ImFileOpen(filename, "wb")) == NULL)
+        return false;
+    WriteBytes(File, "IMDD", 4);
+    WriteValue<ImU32>(File, ImGuiReplayVersion);
+    WriteValue<ImU32>(File, (ImU32)sizeof(ImDrawVert));
+    WriteValue<ImU32>(File, (ImU32)sizeof(ImDrawIdx));
+    WriteValue<int>(File, ImDrawData::GetVtxFormat());
+    FrameCount = 0;
+    return true;
+}
+
+void ImGuiDrawDataDumper::Close()
+{
+    if (File)
+        fclose(File);
+    File = NULL;
+}
+
+void ImGuiDrawDataDumper::DumpFrame(const ImDrawData* draw_data)
+{
+    if (File == NULL)
+        return;
+    const int lists_count = (draw_data && draw_data->Valid) ? draw_data->CmdListsCount : 0;
+    WriteValue<int>(File, FrameCount);
+    WriteValue<int>(File, lists_count);
+    for (int list_n = 0; list_n < lists_count; list_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        WriteValue<int>(File, draw_list->CmdBuffer.Size);
+        WriteValue<int>(File, draw_list->VtxBuffer.Size);
+        WriteValue<int>(File, draw_list->IdxBuffer.Size);
+        for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd* cmd = &draw_list->CmdBuffer.Data[cmd_n];
+            WriteValue<ImU32>(File, cmd->ElemCount);
+            WriteValue<float>(File, cmd->ClipRect.x);
+            WriteValue<float>(File, cmd->ClipRect.y);
+            WriteValue<float>(File, cmd->ClipRect.z);
+            WriteValue<float>(File, cmd->ClipRect.w);
+            WriteValue<ImU64>(File, (ImU64)(intptr_t)cmd->TextureId);
+            WriteValue<ImU32>(File, cmd->UserCallback != NULL ? 1 : 0);
+        }
+        WriteBytes(File, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.Size * sizeof(ImDrawVert));
+        WriteBytes(File, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+    }
+    FrameCount++;
+}
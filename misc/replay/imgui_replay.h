@@ -0,0 +1,67 @@
+// Record and replay of ImGuiIO inputs, and dump of ImDrawData, for Dear ImGui
+// See README.md for usage.
+
+#pragma once
+
+#include "imgui.h"      // IMGUI_API, ImGuiIO, ImDrawData
+#include <stdio.h>      // FILE
+
+// Input state of a frame, as read by ImGui::NewFrame()
+struct ImGuiReplayInputs
+{
+    float       DeltaTime;
+    ImVec2      DisplaySize;
+    ImVec2      MousePos;
+    bool        MouseDown[5];
+    float       MouseWheel;
+    float       MouseWheelH;
+    bool        KeyCtrl, KeyShift, KeyAlt, KeySuper;
+    bool        KeysDown[512];
+    ImWchar     InputCharacters[16+1];
+    float       NavInputs[ImGuiNavInput_COUNT];
+
+    ImGuiReplayInputs()                 { memset(this, 0, sizeof(*this)); }
+    IMGUI_API void  CopyFrom(const ImGuiIO& io);
+    IMGUI_API void  CopyTo(ImGuiIO& io) const;
+};
+
+// Write the inputs of every frame to a file. Only the fields which changed since the previous frame are stored.
+struct IMGUI_API ImGuiInputRecorder
+{
+    FILE*               File;
+    int                 FrameCount;         // Number of frames written so far
+    ImGuiReplayInputs   Prev;               // Inputs of the previous frame
+
+    ImGuiInputRecorder();
+    ~ImGuiInputRecorder();
+    bool        Open(const char* filename);
+    void        Close();
+    void        RecordFrame(const ImGuiIO& io); // Call after your back-end filled the inputs, before ImGui::NewFrame()
+};
+
+// Read a file written by ImGuiInputRecorder and set the inputs of every frame.
+struct IMGUI_API ImGuiInputPlayer
+{
+    FILE*               File;
+    int                 FrameCount;         // Number of frames read so far
+    ImGuiReplayInputs   Current;            // Inputs of the last frame read
+
+    ImGuiInputPlayer();
+    ~ImGuiInputPlayer();
+    bool        Open(const char* filename);
+    void        Close();
+    bool        PlayFrame(ImGuiIO& io);     // Call instead of filling the inputs from your back-end, before ImGui::NewFrame(). Returns false at the end of the recording (io is left untouched).
+};
+
+// Write the raw vertex/index/command streams of ImDrawData to a file, one record per frame, so that two runs can be compared with e.g. 'cmp'.
+struct IMGUI_API ImGuiDrawDataDumper
+{
+    FILE*               File;
+    int                 FrameCount;         // Number of frames written so far
+
+    ImGuiDrawDataDumper();
+    ~ImGuiDrawDataDumper();
+    bool        Open(const char* filename);
+    void        Close();
+    void        DumpFrame(const ImDrawData* draw_data); // Call after ImGui::Render()
+};
@@ -0,0 +1,415 @@
+// Software rasterizer for Dear ImGui: render ImDrawData into a RGBA framebuffer on the CPU, without any GPU API.
+// See README.md for usage.
+
+// Pipeline:
+// - Setup (calling thread): compute edge functions, bounding box and shading mode of every triangle, in submission order.
+// - Binning (calling thread): list the triangles overlapping each tile, preserving submission order.
+// - Rasterization (worker threads): each tile is owned by a single thread, which blends its triangles in order. No synchronization is needed besides fetching the next tile.
+// Coverage follows the top-left rule with pixel centers at (x+0.5,y+0.5). Textures are sampled with nearest filtering.
+
+#include "imgui_soft_raster.h"
+#include "imgui_internal.h"     // ImFileOpen, ImMin, ImMax
+#include <math.h>               // floorf, ceilf, fabsf
+
+#if !defined(IMGUI_SOFT_RASTER_NO_SSE2) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define IMGUI_SOFT_RASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifndef IMGUI_SOFT_RASTER_NO_THREADS
+#include <thread>
+#include <atomic>
+#endif
+
+// a * b / 255, rounded
+static inline unsigned int MulDiv255(unsigned int a, unsigned int b)
+{
+    unsigned int t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+static inline ImU32 ModulateColors(ImU32 a, ImU32 b)
+{
+    return (MulDiv255((a >> IM_COL32_R_SHIFT) & 0xFF, (b >> IM_COL32_R_SHIFT) & 0xFF) << IM_COL32_R_SHIFT) |
+           (MulDiv255((a >> IM_COL32_G_SHIFT) & 0xFF, (b >> IM_COL32_G_SHIFT) & 0xFF) << IM_COL32_G_SHIFT) |
+           (MulDiv255((a >> IM_COL32_B_SHIFT) & 0xFF, (b >> IM_COL32_B_SHIFT) & 0xFF) << IM_COL32_B_SHIFT) |
+           (MulDiv255((a >> IM_COL32_A_SHIFT) & 0xFF, (b >> IM_COL32_A_SHIFT) & 0xFF) << IM_COL32_A_SHIFT);
+}
+
+// Source-over blending, same as glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA) on color channels
+static inline ImU32 BlendOver(ImU32 src, ImU32 dst)
+{
+    const unsigned int a = (src >> IM_COL32_A_SHIFT) & 0xFF;
+    if (a == 255)
+        return src;
+    if (a == 0)
+        return dst;
+    const unsigned int ia = 255 - a;
+    const unsigned int r = MulDiv255((src >> IM_COL32_R_SHIFT) & 0xFF, a) + MulDiv255((dst >> IM_COL32_R_SHIFT) & 0xFF, ia);
+    const unsigned int g = MulDiv255((src >> IM_COL32_G_SHIFT) & 0xFF, a) + MulDiv255((dst >> IM_COL32_G_SHIFT) & 0xFF, ia);
+    const unsigned int b = MulDiv255((src >> IM_COL32_B_SHIFT) & 0xFF, a) + MulDiv255((dst >> IM_COL32_B_SHIFT) & 0xFF, ia);
+    const unsigned int out_a = a + MulDiv255((dst >> IM_COL32_A_SHIFT) & 0xFF, ia);
+    return (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | (out_a << IM_COL32_A_SHIFT);
+}
+
+static inline ImU32 SampleTexture(const ImGuiSoftTexture* tex, float u, float v)
+{
+    if (tex == NULL || tex->Pixels == NULL)
+        return IM_COL32_WHITE;
+    int x = (int)(u * tex->Width);
+    int y = (int)(v * tex->Height);
+    x = x < 0 ? 0 : x >= tex->Width ? tex->Width - 1 : x;
+    y = y < 0 ? 0 : y >= tex->Height ? tex->Height - 1 : y;
+    if (tex->BytesPerPixel == 1)
+        return IM_COL32(255, 255, 255, tex->Pixels[y * tex->Width + x]);
+    return ((const ImU32*)tex->Pixels)[y * tex->Width + x];
+}
+
+static ImU32 ShadePixel(const ImGuiSoftTriangle& tri, float w0, float w1, float w2)
+{
+    const float b0 = w0 * tri.InvArea, b1 = w1 * tri.InvArea, b2 = w2 * tri.InvArea;
+    const float u = tri.UV[0].x * b0 + tri.UV[1].x * b1 + tri.UV[2].x * b2;
+    const float v = tri.UV[0].y * b0 + tri.UV[1].y * b1 + tri.UV[2].y * b2;
+    ImU32 col = 0;
+    const int shifts[4] = { IM_COL32_R_SHIFT, IM_COL32_G_SHIFT, IM_COL32_B_SHIFT, IM_COL32_A_SHIFT };
+    for (int n = 0; n < 4; n++)
+    {
+        const int s = shifts[n];
+        float c = ((tri.Col[0] >> s) & 0xFF) * b0 + ((tri.Col[1] >> s) & 0xFF) * b1 + ((tri.Col[2] >> s) & 0xFF) * b2 + 0.5f;
+        unsigned int ci = c <= 0.0f ? 0 : c >= 255.0f ? 255 : (unsigned int)c;
+        col |= ci << s;
+    }
+    return ModulateColors(col, SampleTexture(tri.Texture, u, v));
+}
+
+// Setup a triangle. Returns false if it doesn't cover any pixel.
+static bool SetupTriangle(ImGuiSoftTriangle* tri, const ImDrawVert& v0, const ImDrawVert& v1, const ImDrawVert& v2, const ImGuiSoftTexture* tex, int clip_x0, int clip_y0, int clip_x1, int clip_y1)
+{
+    const ImVec2 p[3] = { (ImVec2)v0.pos, (ImVec2)v1.pos, (ImVec2)v2.pos };
+    const float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+    if (area == 0.0f || area != area)
+        return false;
+
+    // Bounding box of the pixel centers covered by the triangle
+    const float min_x = ImMin(ImMin(p[0].x, p[1].x), p[2].x), max_x = ImMax(ImMax(p[0].x, p[1].x), p[2].x);
+    const float min_y = ImMin(ImMin(p[0].y, p[1].y), p[2].y), max_y = ImMax(ImMax(p[0].y, p[1].y), p[2].y);
+    tri->MinX = ImMax((int)ceilf(min_x - 0.5f), clip_x0);
+    tri->MinY = ImMax((int)ceilf(min_y - 0.5f), clip_y0);
+    tri->MaxX = ImMin((int)floorf(max_x - 0.5f) + 1, clip_x1);
+    tri->MaxY = ImMin((int)floorf(max_y - 0.5f) + 1, clip_y1);
+    if (tri->MinX >= tri->MaxX || tri->MinY >= tri->MaxY)
+        return false;
+
+    // Edge i goes from vertex (i+1)%3 to vertex (i+2)%3. We always evaluate it from its lowest endpoint.
+    const float orientation = (area > 0.0f) ? 1.0f : -1.0f;
+    tri->EdgeIncludeZero = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        ImVec2 a = p[(i + 1) % 3], b = p[(i + 2) % 3];
+        float sign = orientation;   // (b-a) x (p-a) has the sign of the triangle area for points inside the triangle
+        if (b.x < a.x || (b.x == a.x && b.y < a.y))
+        {
+            ImVec2 tmp = a; a = b; b = tmp;
+            sign = -sign;
+        }
+        tri->EdgeX[i] = a.x;
+        tri->EdgeY[i] = a.y;
+        tri->EdgeDX[i] = b.x - a.x;
+        tri->EdgeDY[i] = b.y - a.y;
+        tri->EdgeSign[i] = sign;
+
+        // Top-left rule: gradient of w points right, or down on horizontal edges
+        const float grad_x = -sign * tri->EdgeDY[i], grad_y = sign * tri->EdgeDX[i];
+        if (grad_x > 0.0f || (grad_x == 0.0f && grad_y > 0.0f))
+            tri->EdgeIncludeZero |= 1 << i;
+    }
+    tri->InvArea = 1.0f / fabsf(area);
+    tri->UV[0] = (ImVec2)v0.uv; tri->UV[1] = (ImVec2)v1.uv; tri->UV[2] = (ImVec2)v2.uv;
+    tri->Col[0] = v0.col; tri->Col[1] = v1.col; tri->Col[2] = v2.col;
+    tri->Texture = tex;
+    tri->Uniform = (v0.col == v1.col && v0.col == v2.col && tri->UV[0].x == tri->UV[1].x && tri->UV[0].x == tri->UV[2].x && tri->UV[0].y == tri->UV[1].y && tri->UV[0].y == tri->UV[2].y);
+    tri->UniformCol = tri->Uniform ? ModulateColors(v0.col, SampleTexture(tex, tri->UV[0].x, tri->UV[0].y)) : 0;
+    if (tri->Uniform && ((tri->UniformCol >> IM_COL32_A_SHIFT) & 0xFF) == 0)
+        return false;
+    return true;
+}
+
+static void RasterTriangleInRect(const ImGuiSoftTriangle& tri, ImU32* pixels, int stride, int x0, int y0, int x1, int y1)
+{
+#ifdef IMGUI_SOFT_RASTER_SSE2
+    const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 e_dy[3], e_x[3], e_sign[3], e_incl[3];
+    for (int i = 0; i < 3; i++)
+    {
+        e_dy[i] = _mm_set1_ps(tri.EdgeDY[i]);
+        e_x[i] = _mm_set1_ps(tri.EdgeX[i]);
+        e_sign[i] = _mm_set1_ps(tri.EdgeSign[i]);
+        e_incl[i] = (tri.EdgeIncludeZero & (1 << i)) ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+    }
+#endif
+    for (int y = y0; y < y1; y++)
+    {
+        const float py = (float)y + 0.5f;
+        float row[3];   // DX * (py - Y), shared by the pixels of the row
+        for (int i = 0; i < 3; i++)
+            row[i] = tri.EdgeDX[i] * (py - tri.EdgeY[i]);
+        ImU32* dst = pixels + y * stride;
+
+#ifdef IMGUI_SOFT_RASTER_SSE2
+        // 4 pixels at a time, with the same operations as the scalar version. Lanes past x1 are masked out.
+        __m128 e_row[3];
+        for (int i = 0; i < 3; i++)
+            e_row[i] = _mm_set1_ps(row[i]);
+        for (int x = x0; x < x1; x += 4)
+        {
+            const __m128 px = _mm_add_ps(_mm_set1_ps((float)x), lane_offsets);
+            __m128 w[3];
+            __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+            for (int i = 0; i < 3; i++)
+            {
+                w[i] = _mm_mul_ps(e_sign[i], _mm_sub_ps(e_row[i], _mm_mul_ps(e_dy[i], _mm_sub_ps(px, e_x[i]))));
+                __m128 edge_in = _mm_or_ps(_mm_cmpgt_ps(w[i], zero), _mm_and_ps(_mm_cmpeq_ps(w[i], zero), e_incl[i]));
+                inside = _mm_and_ps(inside, edge_in);
+            }
+            int mask = _mm_movemask_ps(inside);
+            if (x + 4 > x1)
+                mask &= (1 << (x1 - x)) - 1;
+            if (mask == 0)
+                continue;
+            if (tri.Uniform)
+            {
+                for (int lane = 0; lane < 4; lane++)
+                    if (mask & (1 << lane))
+                        dst[x + lane] = BlendOver(tri.UniformCol, dst[x + lane]);
+                continue;
+            }
+            float w0[4], w1[4], w2[4];
+            _mm_storeu_ps(w0, w[0]);
+            _mm_storeu_ps(w1, w[1]);
+            _mm_storeu_ps(w2, w[2]);
+            for (int lane = 0; lane < 4; lane++)
+                if (mask & (1 << lane))
+                    dst[x + lane] = BlendOver(ShadePixel(tri, w0[lane], w1[lane], w2[lane]), dst[x + lane]);
+        }
+#else
+        for (int x = x0; x < x1; x++)
+        {
+            const float px = (float)x + 0.5f;
+            float w[3];
+            bool inside = true;
+            for (int i = 0; i < 3 && inside; i++)
+            {
+                w[i] = tri.EdgeSign[i] * (row[i] - tri.EdgeDY[i] * (px - tri.EdgeX[i]));
+                inside = (w[i] > 0.0f) || (w[i] == 0.0f && (tri.EdgeIncludeZero & (1 << i)));
+            }
+            if (!inside)
+                continue;
+            dst[x] = BlendOver(tri.Uniform ? tri.UniformCol : ShadePixel(tri, w[0], w[1], w[2]), dst[x]);
+        }
+#endif
+    }
+}
+
+// Rasterize all the triangles binned into one tile, optionally clearing it first
+static void RasterTile(ImGuiSoftRenderer* r, int tile_n, bool clear, ImU32 clear_col)
+{
+    const int tiles_x = (r->Width + r->TileSize - 1) / r->TileSize;
+    const int tile_x0 = (tile_n % tiles_x) * r->TileSize, tile_y0 = (tile_n / tiles_x) * r->TileSize;
+    const int tile_x1 = ImMin(tile_x0 + r->TileSize, r->Width), tile_y1 = ImMin(tile_y0 + r->TileSize, r->Height);
+    if (clear)
+        for (int y = tile_y0; y < tile_y1; y++)
+            for (int x = tile_x0; x < tile_x1; x++)
+                r->Pixels.Data[y * r->Width + x] = clear_col;
+    for (int bin_n = r->TileBinStart[tile_n]; bin_n < r->TileBinStart[tile_n + 1]; bin_n++)
+    {
+        const ImGuiSoftTriangle& tri = r->Triangles[r->TileBinTriangles[bin_n]];
+        RasterTriangleInRect(tri, r->Pixels.Data, r->Width, ImMax(tri.MinX, tile_x0), ImMax(tri.MinY, tile_y0), ImMin(tri.MaxX, tile_x1), ImMin(tri.MaxY, tile_y1));
+    }
+}
+
+#ifndef IMGUI_SOFT_RASTER_NO_THREADS
+static void RasterTilesWorker(ImGuiSoftRenderer* r, std::atomic<int>* next_tile, bool clear, ImU32 clear_col)
+{
+    for (int n = (*next_tile)++; n < r->TilesToRender.Size; n = (*next_tile)++)
+        RasterTile(r, r->TilesToRender[n], clear, clear_col);
+}
+#endif
+
+// Setup and bin the triangles of draw_data, then rasterize all tiles, or clear and rasterize only the tiles overlapping draw_data->DamageRects[]
+static void RenderDrawDataTiles(ImGuiSoftRenderer* r, ImDrawData* draw_data, bool damage_only, ImU32 clear_col)
+{
+    IM_ASSERT(r->TileSize > 0);
+    if (r->Width <= 0 || r->Height <= 0 || draw_data == NULL)
+        return;
+
+    // Setup triangles
+    r->Triangles.resize(0);
+    r->Triangles.reserve(draw_data->TotalIdxCount / 3);
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[list_n];
+        const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data;
+        const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data;
+        for (int cmd_n = 0; cmd_n < cmd_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_n];
+            if (pcmd->UserCallback)
+            {
+                pcmd->UserCallback(cmd_list, pcmd);
+            }
+            else
+            {
+                const ImGuiSoftTexture* tex = (const ImGuiSoftTexture*)pcmd->TextureId;
+                const int clip_x0 = ImMax((int)pcmd->ClipRect.x, 0), clip_y0 = ImMax((int)pcmd->ClipRect.y, 0);
+                const int clip_x1 = ImMin((int)pcmd->ClipRect.z, r->Width), clip_y1 = ImMin((int)pcmd->ClipRect.w, r->Height);
+                if (clip_x0 < clip_x1 && clip_y0 < clip_y1)
+                {
+                    for (unsigned int elem_n = 0; elem_n + 2 < pcmd->ElemCount; elem_n += 3)
+                    {
+                        r->Triangles.resize(r->Triangles.Size + 1);
+                        if (!SetupTriangle(&r->Triangles.back(), vtx_buffer[idx_buffer[elem_n]], vtx_buffer[idx_buffer[elem_n + 1]], vtx_buffer[idx_buffer[elem_n + 2]], tex, clip_x0, clip_y0, clip_x1, clip_y1))
+                            r->Triangles.pop_back();
+                    }
+                }
+            }
+            idx_buffer += pcmd->ElemCount;
+        }
+    }
+
+    // Bin triangles into tiles: count, prefix sum, then fill in submission order
+    const int tiles_x = (r->Width + r->TileSize - 1) / r->TileSize, tiles_y = (r->Height + r->TileSize - 1) / r->TileSize;
+    const int tiles_count = tiles_x * tiles_y;
+    r->TileBinStart.resize(tiles_count + 1);
+    memset(r->TileBinStart.Data, 0, (size_t)r->TileBinStart.Size * sizeof(int));
+    for (int tri_n = 0; tri_n < r->Triangles.Size; tri_n++)
+    {
+        const ImGuiSoftTriangle& tri = r->Triangles[tri_n];
+        for (int ty = tri.MinY / r->TileSize; ty <= (tri.MaxY - 1) / r->TileSize; ty++)
+            for (int tx = tri.MinX / r->TileSize; tx <= (tri.MaxX - 1) / r->TileSize; tx++)
+                r->TileBinStart[ty * tiles_x + tx + 1]++;
+    }
+    for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+        r->TileBinStart[tile_n + 1] += r->TileBinStart[tile_n];
+    r->TileBinTriangles.resize(r->TileBinStart[tiles_count]);
+    ImVector<int> tile_write_pos;
+    tile_write_pos.resize(tiles_count);
+    memcpy(tile_write_pos.Data, r->TileBinStart.Data, (size_t)tiles_count * sizeof(int));
+    for (int tri_n = 0; tri_n < r->Triangles.Size; tri_n++)
+    {
+        const ImGuiSoftTriangle& tri = r->Triangles[tri_n];
+        for (int ty = tri.MinY / r->TileSize; ty <= (tri.MaxY - 1) / r->TileSize; ty++)
+            for (int tx = tri.MinX / r->TileSize; tx <= (tri.MaxX - 1) / r->TileSize; tx++)
+                r->TileBinTriangles[tile_write_pos[ty * tiles_x + tx]++] = tri_n;
+    }
+
+    // List tiles to rasterize
+    r->TilesToRender.resize(0);
+    if (!damage_only)
+    {
+        for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+            r->TilesToRender.push_back(tile_n);
+    }
+    else
+    {
+        ImVector<bool> tile_damaged;
+        tile_damaged.resize(tiles_count, false);
+        for (int rect_n = 0; rect_n < draw_data->DamageRectsCount; rect_n++)
+        {
+            const ImVec4& rect = draw_data->DamageRects[rect_n];
+            const int x0 = ImMax((int)rect.x, 0), y0 = ImMax((int)rect.y, 0);
+            const int x1 = ImMin((int)ceilf(rect.z), r->Width), y1 = ImMin((int)ceilf(rect.w), r->Height);
+            if (x0 >= x1 || y0 >= y1)
+                continue;
+            for (int ty = y0 / r->TileSize; ty <= (y1 - 1) / r->TileSize; ty++)
+                for (int tx = x0 / r->TileSize; tx <= (x1 - 1) / r->TileSize; tx++)
+                    tile_damaged[ty * tiles_x + tx] = true;
+        }
+        for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+            if (tile_damaged[tile_n])
+                r->TilesToRender.push_back(tile_n);
+    }
+
+    // Rasterize tiles
+#ifndef IMGUI_SOFT_RASTER_NO_THREADS
+    int threads_count = (r->ThreadsCount > 0) ? r->ThreadsCount : (int)std::thread::hardware_concurrency();
+    threads_count = ImMax(ImMin(threads_count, r->TilesToRender.Size), 1);
+    if (threads_count > 1)
+    {
+        std::atomic<int> next_tile(0);
+        ImVector<std::thread*> threads;
+        for (int n = 1; n < threads_count; n++)
+            threads.push_back(new std::thread(RasterTilesWorker, r, &next_tile, damage_only, clear_col));
+        RasterTilesWorker(r, &next_tile, damage_only, clear_col);
+        for (int n = 0; n < threads.Size; n++)
+        {
+            threads[n]->join();
+            delete threads[n];
+        }
+        return;
+    }
+#endif
+    for (int n = 0; n < r->TilesToRender.Size; n++)
+        RasterTile(r, r->TilesToRender[n], damage_only, clear_col);
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiSoftRenderer
+//-----------------------------------------------------------------------------
+
+ImGuiSoftRenderer::ImGuiSoftRenderer()
+{
+    Width = Height = 0;
+    TileSize = 64;
+    ThreadsCount = 0;
+}
+
+void ImGuiSoftRenderer::SetSize(int width, int height)
+{
+    IM_ASSERT(width >= 0 && height >= 0);
+    Width = width;
+    Height = height;
+    Pixels.resize(width * height);
+}
+
+void ImGuiSoftRenderer::Clear(ImU32 col)
+{
+    for (int n = 0; n < Pixels.Size; n++)
+        Pixels.Data[n] = col;
+}
+
+void ImGuiSoftRenderer::RenderDrawData(ImDrawData* draw_data)
+{
+    RenderDrawDataTiles(this, draw_data, false, 0);
+}
+
+void ImGuiSoftRenderer::RenderDrawDataDamage(ImDrawData* draw_data, ImU32 clear_col)
+{
+    RenderDrawDataTiles(this, draw_data, true, clear_col);
+}
+
+bool ImGuiSoftRenderer::SaveTGA(const char* filename) const
+{
+    FILE* f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const unsigned char header[18] = { 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, (unsigned char)(Width & 0xFF), (unsigned char)(Width >> 8), (unsigned char)(Height & 0xFF), (unsigned char)(Height >> 8), 32, 0x28 }; // Uncompressed true-color, 8 bits alpha, top-left origin
+    fwrite(header, 1, sizeof(header), f);
+    ImVector<unsigned char> row;
+    row.resize(Width * 4);
+    for (int y = 0; y < Height; y++)
+    {
+        for (int x = 0; x < Width; x++)
+        {
+            const ImU32 c = Pixels[y * Width + x];
+            row[x * 4 + 0] = (unsigned char)(c >> IM_COL32_B_SHIFT);
+            row[x * 4 + 1] = (unsigned char)(c >> IM_COL32_G_SHIFT);
+            row[x * 4 + 2] = (unsigned char)(c >> IM_COL32_R_SHIFT);
+            row[x * 4 + 3] = (unsigned char)(c >> IM_COL32_A_SHIFT);
+        }
+        fwrite(row.Data, 1, (size_t)row.Size, f);
+    }
+    bool ok = (ferror(f) == 0);
+    fclose(f);
+    return ok;
+}
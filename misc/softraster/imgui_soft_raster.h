@@ -0,0 +1,52 @@
+// Software rasterizer for Dear ImGui: render ImDrawData into a RGBA framebuffer on the CPU, without any GPU API.
+// See README.md for usage.
+
+#pragma once
+
+#include "imgui.h"      // IMGUI_API, ImDrawData, ImVector
+
+// Texture to use as ImTextureID (e.g. io.Fonts->TexID = &my_soft_texture). A NULL ImTextureID samples as opaque white.
+struct ImGuiSoftTexture
+{
+    const unsigned char*    Pixels;
+    int                     Width, Height;
+    int                     BytesPerPixel;  // 1: alpha only (e.g. GetTexDataAsAlpha8(), sampled as white), 4: RGBA (e.g. GetTexDataAsRGBA32(), IM_COL32 layout)
+
+    ImGuiSoftTexture()      { Pixels = NULL; Width = Height = 0; BytesPerPixel = 4; }
+};
+
+// Triangle after setup, binned into tiles (internal)
+struct ImGuiSoftTriangle
+{
+    float                   EdgeX[3], EdgeY[3], EdgeDX[3], EdgeDY[3];  // Edge i is opposite to vertex i: w(i) = Sign(i) * (DX * (py - Y) - DY * (px - X)), > 0 inside
+    float                   EdgeSign[3];                                // +1.0f or -1.0f. Shared edges are always evaluated from the same endpoint, so neighbor triangles agree exactly on coverage.
+    int                     EdgeIncludeZero;                            // Bit i set when pixels exactly on edge i belong to this triangle (top-left rule)
+    float                   InvArea;                                    // Barycentric weight of vertex i = w(i) * InvArea
+    ImVec2                  UV[3];
+    ImU32                   Col[3];
+    ImU32                   UniformCol;                                 // When Uniform: vertex color * texture color, same for every pixel
+    bool                    Uniform;                                    // Same color and UV on the 3 vertices
+    const ImGuiSoftTexture* Texture;
+    int                     MinX, MinY, MaxX, MaxY;                     // Bounding box clipped to the clip rectangle and framebuffer, in pixels (max exclusive)
+};
+
+struct IMGUI_API ImGuiSoftRenderer
+{
+    int                     Width, Height;
+    ImVector<ImU32>         Pixels;             // Framebuffer, Width*Height pixels in IM_COL32 layout (R,G,B,A bytes in memory by default)
+    int                     TileSize;           // = 64     // Size of the tiles rasterized by each worker, in pixels
+    int                     ThreadsCount;       // = 0      // Number of threads rasterizing tiles, including the calling thread. 0: use the number of hardware threads.
+
+    // Internal buffers, reused across frames
+    ImVector<ImGuiSoftTriangle> Triangles;
+    ImVector<int>           TileBinStart;       // For each tile, index of its first triangle in TileBinTriangles[] (TilesCount+1 entries)
+    ImVector<int>           TileBinTriangles;   // Triangles overlapping each tile, in submission order
+    ImVector<int>           TilesToRender;      // Tiles rasterized by the current call
+
+    ImGuiSoftRenderer();
+    void        SetSize(int width, int height);
+    void        Clear(ImU32 col);
+    void        RenderDrawData(ImDrawData* draw_data);  // Blend draw_data over the current content of the framebuffer. Draw callbacks are called during the (serial) setup pass.
+    void        RenderDrawDataDamage(ImDrawData* draw_data, ImU32 clear_col);   // Clear and redraw only the tiles overlapping draw_data->DamageRects[] (see io.OptDamageRects). The framebuffer must contain the previous frame.
+    bool        SaveTGA(const char* filename) const;    // Write the framebuffer to an uncompressed 32-bit TGA file, e.g. for regression screenshots.
+};